@@ -0,0 +1,306 @@
+// Microbenchmark-uri pentru nucleele fierbinti, pe intrari fixe (seed-uri
+// constante), ca optimizarile unui nucleu sa poata fi verificate izolat.
+// Fiecare caz e calibrat la ~BATCH_MS pe lot si repetat de `reps` ori;
+// se raporteaza media ns/op, abaterea standard, coeficientul de variatie,
+// minimul si op/s.
+//
+// Utilizare: microbench [--filter SUBSIR] [--reps N]
+#include "agents.h"
+#include "config.h"
+#include "hivemind.h"
+#include "map.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const double BATCH_MS = 20.0;
+
+// Impiedica eliminarea rezultatelor de catre compilator
+volatile long long sink = 0;
+
+class Microbench {
+public:
+    // batch(n) executa n operatii si intoarce nanosecundele masurate
+    typedef function<double(long long)> Batch;
+
+    Microbench(const string& _filter, int _reps) : filter(_filter), reps(_reps) {}
+
+    bool wants(const string& name) const { return filter.empty() || name.find(filter) != string::npos; }
+
+    void run(const string& name, const Batch& batch) {
+        if (!wants(name)) return;
+
+        // Calibrare (tine loc si de incalzire): dublam lotul pana trece de BATCH_MS
+        long long n = 1;
+        while (batch(n) < BATCH_MS * 1e6 && n < (1LL << 40)) n *= 2;
+
+        vector<double> samples;
+        for (int r = 0; r < reps; r++) samples.push_back(batch(n) / n);
+
+        double mean = 0.0;
+        for (double s : samples) mean += s;
+        mean /= samples.size();
+        double var = 0.0;
+        for (double s : samples) var += (s - mean) * (s - mean);
+        double stddev = samples.size() > 1 ? sqrt(var / (samples.size() - 1)) : 0.0;
+        double best = *min_element(samples.begin(), samples.end());
+
+        cout << left << setw(34) << name << right << fixed
+             << setprecision(1) << setw(12) << mean
+             << setw(11) << stddev
+             << setw(8) << (mean > 0 ? 100.0 * stddev / mean : 0.0) << "%"
+             << setw(12) << best
+             << setprecision(0) << setw(14) << (mean > 0 ? 1e9 / mean : 0.0) << endl;
+    }
+
+    // Varianta obisnuita: operatiile lotului sunt cronometrate in bloc.
+    // `rewind` (necronometrat) readuce intrarile la inceput, deci fiecare
+    // repetare masoara exact aceeasi munca.
+    template <typename Rewind, typename Op>
+    void runOps(const string& name, Rewind rewind, Op op) {
+        run(name, [&rewind, &op](long long n) {
+            rewind();
+            auto start = chrono::steady_clock::now();
+            for (long long i = 0; i < n; i++) op();
+            return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    static void printHeader() {
+        cout << left << setw(34) << "CAZ" << right << setw(12) << "NS/OP" << setw(11) << "STDDEV"
+             << setw(9) << "CV" << setw(12) << "MIN" << setw(14) << "OP/S" << endl;
+    }
+
+private:
+    string filter;
+    int reps;
+};
+
+ScenarioConfig makeConfig(int size, int fleet) {
+    ScenarioConfig config;
+    config.mapHeight = size;
+    config.mapWidth = size;
+    config.maxTicks = 1000;
+    config.maxStations = max(2, size / 20);
+    config.clientsCount = max(10, size / 2);
+    // Proportia din simulation_setup.txt (3:2:1), backlog proportional cu flota
+    config.dronesCount = fleet / 2;
+    config.robotsCount = fleet / 3;
+    config.scootersCount = fleet - config.dronesCount - config.robotsCount;
+    config.spawnFrequency = 10;
+    config.packagesPerSpawn = max(1, fleet / 6);
+    config.totalPackages = config.packagesPerSpawn * (config.maxTicks / config.spawnFrequency);
+    return config;
+}
+
+struct PathQuery {
+    Point start;
+    Point target;
+};
+
+// Perechi start/tinta conectate, oricat de departe, pe harta data
+vector<PathQuery> buildQueries(const Map& map, int count, mt19937& rng) {
+    vector<PathQuery> queries;
+    vector<uint64_t> reached;
+    uniform_int_distribution<int> coord(0, map.getWidth() - 1);
+
+    while ((int)queries.size() < count) {
+        Point start = {coord(rng), coord(rng)};
+        if (!map.isWalkable(start.x, start.y)) continue;
+        map.floodFill(start, reached);
+        for (int tries = 0; tries < 100; tries++) {
+            Point target = {coord(rng), coord(rng)};
+            if (target != start && map.isReached(reached, target)) {
+                queries.push_back({start, target});
+                break;
+            }
+        }
+    }
+    return queries;
+}
+
+void benchPathfinding(Microbench& bench) {
+    const int sizes[] = {20, 50, 100, 200};
+    const double densities[] = {0.0, 0.2};
+    const PathfinderType types[] = {PATHFINDER_BFS, PATHFINDER_ASTAR, PATHFINDER_JPS};
+    const char* names[] = {"bfs", "astar", "jps"};
+
+    for (int size : sizes) {
+        for (double density : densities) {
+            mt19937 rng(42);
+            Map map;
+            map.init(size, size);
+            uniform_int_distribution<int> coord(0, size - 1);
+            for (int i = 0; i < (int)(size * size * density); i++) map.setCell(coord(rng), coord(rng), CELL_WALL);
+            vector<PathQuery> queries = buildQueries(map, 256, rng);
+
+            for (int t = 0; t < 3; t++) {
+                string name = string("path/") + names[t] + "/" + to_string(size) + "/ziduri" +
+                              to_string((int)(density * 100));
+                if (!bench.wants(name)) continue;
+                unique_ptr<IPathfinder> pathfinder = PathfinderFactory::create(types[t]);
+                size_t k = 0;
+                bench.runOps(name, [&] { k = 0; }, [&] {
+                    const PathQuery& q = queries[k++ % queries.size()];
+                    Point next = pathfinder->findNextStep(q.start, q.target, map);
+                    sink += next.x + next.y;
+                });
+            }
+        }
+    }
+}
+
+void benchAssignmentScore(Microbench& bench) {
+    const int fleets[] = {10, 100, 1000};
+    const int backlogs[] = {16, 256};
+
+    ScenarioConfig config = makeConfig(50, 6);
+    ConnectedMapGenerator generator;
+    generator.seed(42);
+    Map map;
+    generator.generate(map, config);
+
+    Arena scratch;
+    HiveMind hiveMind(scratch);
+    const vector<Point>& clients = map.getClients();
+
+    for (int fleetSize : fleets) {
+        ScenarioConfig fleetConfig = makeConfig(50, fleetSize);
+        Fleet fleet;
+        fleet.init(fleetConfig.dronesCount, fleetConfig.robotsCount, fleetConfig.scootersCount,
+                   map.getBasePosition());
+
+        for (int backlog : backlogs) {
+            string name = "score/agenti" + to_string(fleetSize) + "/pachete" + to_string(backlog);
+            if (!bench.wants(name)) continue;
+
+            mt19937 rng(7);
+            uniform_int_distribution<int> clientDist(0, (int)clients.size() - 1);
+            vector<Package> packages;
+            for (int p = 0; p < backlog; p++) {
+                packages.emplace_back(p, clients[clientDist(rng)], 500, 20 + p % 10, 0, 0);
+            }
+
+            size_t k = 0;
+            size_t pairs = (size_t)fleet.size() * packages.size();
+            bench.runOps(name, [&] { k = 0; }, [&] {
+                size_t pair = k++ % pairs;
+                Agent* agent = fleet.get((int)(pair / packages.size()));
+                Package* package = &packages[pair % packages.size()];
+                sink += (long long)hiveMind.calculateAssignmentScore(agent, package, map, 0);
+            });
+        }
+    }
+}
+
+void benchMapGeneration(Microbench& bench) {
+    const int sizes[] = {20, 50, 100};
+
+    for (int size : sizes) {
+        ScenarioConfig config = makeConfig(size, 6);
+        string suffix = "/" + to_string(size);
+
+        // Fara campuri de distanta: se masoara doar generarea si validarea
+        ProceduralMapGenerator procedural;
+        procedural.setBuildDistanceFields(false);
+        Map map;
+        bench.runOps("mapgen/respingere" + suffix, [&] { procedural.seed(42); }, [&] {
+            try {
+                procedural.generate(map, config);
+                sink += procedural.getLastAttempts();
+            } catch (const exception&) {
+                sink += 1;
+            }
+        });
+
+        ConnectedMapGenerator connected;
+        connected.setBuildDistanceFields(false);
+        bench.runOps("mapgen/conex" + suffix, [&] { connected.seed(42); }, [&] {
+            connected.generate(map, config);
+            sink += map.getClients().size();
+        });
+
+        vector<Map> maps(16);
+        connected.seed(7);
+        for (auto& m : maps) connected.generate(m, config);
+        size_t k = 0;
+        bench.runOps("mapgen/validateMap" + suffix, [&] { k = 0; }, [&] {
+            sink += procedural.validateMap(maps[k++ % maps.size()]);
+        });
+
+        bench.runOps("mapgen/campuri" + suffix, [&] { k = 0; }, [&] {
+            maps[k++ % maps.size()].buildDistanceFields();
+        });
+    }
+}
+
+void benchSimulationTick(Microbench& bench) {
+    const int fleets[] = {6, 60, 600};
+
+    for (int fleetSize : fleets) {
+        string name = "tick/agenti" + to_string(fleetSize);
+        if (!bench.wants(name)) continue;
+
+        Simulation sim(makeConfig(20, fleetSize));
+
+        // Fiecare lot reia aceleasi tick-uri: scenariile 0, 1, ... de la
+        // inceput. Doar step() e cronometrat, nu si reinitializarea.
+        bench.run(name, [&](long long n) {
+            double ns = 0.0;
+            long long done = 0;
+            for (int scenario = 0; done < n; scenario++) {
+                sim.reset(Simulation::scenarioSeed(1, scenario));
+                sim.initialize(scenario);
+                auto start = chrono::steady_clock::now();
+                bool running = true;
+                for (; done < n && running; done++) running = sim.step();
+                ns += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+            }
+            return ns;
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    string filter;
+    int reps = 10;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = max(2, atoi(argv[++i]));
+        else {
+            cerr << "Utilizare: " << argv[0] << " [--filter SUBSIR] [--reps N]" << endl;
+            return 1;
+        }
+    }
+
+    Microbench bench(filter, reps);
+    cout << "--- MICROBENCHMARK-URI ---" << endl;
+    cout << reps << " repetari per caz, loturi de ~" << BATCH_MS << " ms, intrari fixe." << endl;
+    Microbench::printHeader();
+
+    try {
+        benchPathfinding(bench);
+        benchAssignmentScore(bench);
+        benchMapGeneration(bench);
+        benchSimulationTick(bench);
+    } catch (const exception& e) {
+        cerr << "Eroare: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -3,9 +3,11 @@
 
 #include "utils.h"
 #include <memory>
+#include <vector>
 
 class Map;
 struct Package;
+class TraceWriter;
 
 enum AgentState { 
     IDLE,       
@@ -20,73 +22,170 @@ enum AgentType {
     SCOOTER 
 };
 
-class Agent {
+enum PathfinderType {
+    PATHFINDER_BFS,
+    PATHFINDER_ASTAR,
+    PATHFINDER_JPS
+};
+
+// Cautare de drum pentru tintele care nu au camp de distanta precalculat in Map
+class IPathfinder {
 protected:
-    int id;
-    AgentType type;
-    Point position;
-    Point target;
-    float battery;
+    int lastExpanded; // noduri expandate la ultima cautare
+
+public:
+    IPathfinder() : lastExpanded(0) {}
+    virtual ~IPathfinder() {}
+
+    // Primul pas pe un drum minim start -> target; start daca nu exista drum
+    virtual Point findNextStep(const Point& start, const Point& target, const Map& map) = 0;
+    int getLastExpanded() const { return lastExpanded; }
+};
+
+class BfsPathfinder : public IPathfinder {
+public:
+    Point findNextStep(const Point& start, const Point& target, const Map& map) override;
+};
+
+class AStarPathfinder : public IPathfinder {
+public:
+    Point findNextStep(const Point& start, const Point& target, const Map& map) override;
+};
+
+class JpsPathfinder : public IPathfinder {
+public:
+    Point findNextStep(const Point& start, const Point& target, const Map& map) override;
+};
+
+class PathfinderFactory {
+public:
+    static std::unique_ptr<IPathfinder> create(PathfinderType type);
+};
+
+// Parametrii ficsi ai fiecarui tip de agent
+struct AgentSpec {
     float maxBattery;
     float consumption;
     int costPerTick;
-    AgentState state;
-    Package* currentPackage;
-    bool hasPhysicalPackage;
+    int speed;
+};
+
+const AgentSpec& getAgentSpec(AgentType type);
+
+class Fleet;
+
+// Vedere asupra unui agent din Fleet: datele stau in tablourile flotei,
+// obiectul retine doar indexul. Pointerii la Agent raman stabili cat timp
+// flota nu este reinitializata.
+class Agent {
+private:
+    Fleet* fleet;
+    int slot;
 
 public:
-    Agent(int _id, int x, int y, AgentType _type, 
-    float _maxBattery, float _consumption, int _costPerTick);
-    virtual ~Agent() = default;
+    Agent(Fleet* _fleet, int _slot) : fleet(_fleet), slot(_slot) {}
 
-    virtual void move(const Map& map) = 0;
-    virtual float getSpeed() const = 0;
-    
-    void charge();
     void assignTask(Package* pkg, Point dest);
     void sendToCharge(Point station);
     void dropPackage();
-    void updatePosition(Point newPos);
     
-    int getId() const { return id; }
-    AgentType getType() const { return type; }
-    AgentState getState() const { return state; }
-    Point getPosition() const { return position; }
-    Point getTarget() const { return target; }
-    float getBattery() const { return battery; }
-    float getBatteryPercentage() const { return (battery / maxBattery) * 100.0f; }
-    float getConsumption() const { return consumption; }
-    int getOperationalCost() const { return costPerTick; }
-    bool isAlive() const { return state != DEAD; }
-    bool isBusy() const { return currentPackage != nullptr; }
-    Package* getPackage() const { return currentPackage; }
+    int getSlot() const { return slot; }
+    int getId() const;
+    AgentType getType() const;
+    AgentState getState() const;
+    Point getPosition() const;
+    Point getTarget() const;
+    float getBattery() const;
+    float getBatteryPercentage() const;
+    float getConsumption() const { return getAgentSpec(getType()).consumption; }
+    float getSpeed() const { return static_cast<float>(getAgentSpec(getType()).speed); }
+    int getOperationalCost() const { return getAgentSpec(getType()).costPerTick; }
+    bool isAlive() const { return getState() != DEAD; }
+    bool isBusy() const { return getPackage() != nullptr; }
+    Package* getPackage() const;
     
-    void setState(AgentState newState) { state = newState; }
+    void setState(AgentState newState);
 };
 
-class Drone : public Agent {
-public:
-    Drone(int id, int x, int y);
-    void move(const Map& map) override;
-    float getSpeed() const override { return 3.0f; }
-};
+// Totalurile unui tick pe un interval de agenti, adunate apoi pe toata flota
+struct FleetTickTotals {
+    long long cost = 0;   // costul operational
+    int deaths = 0;       // agenti morti in acest tick
 
-class Robot : public Agent {
-public:
-    Robot(int id, int x, int y);
-    void move(const Map& map) override;
-    float getSpeed() const override { return 1.0f; }
+    void merge(const FleetTickTotals& other) {
+        cost += other.cost;
+        deaths += other.deaths;
+    }
 };
 
-class Scooter : public Agent {
-public:
-    Scooter(int id, int x, int y);
-    void move(const Map& map) override;
-    float getSpeed() const override { return 2.0f; }
-};
+// Flota stocata ca structura de tablouri, grupata pe tip: [drone | roboti | scutere].
+// Consumul, incarcarea si costurile ruleaza ca bucle stranse pe fiecare tip.
+class Fleet {
+private:
+    std::vector<int> ids;
+    std::vector<AgentType> types;
+    std::vector<int> posX, posY;
+    std::vector<int> targetX, targetY;
+    std::vector<float> battery;
+    std::vector<AgentState> states;
+    std::vector<Package*> packages;
+    std::vector<int> carrying; // are pachetul fizic (l-a ridicat de la baza)
+    int typeOffset[4];         // agentii de tipul t sunt in [typeOffset[t], typeOffset[t+1])
+
+    std::vector<Agent> handles;
+    IPathfinder* pathfinder;   // nullptr = BFS implicit
+    TraceWriter* trace;        // deciziile de atribuire/incarcare, daca e setat
+
+    // Buffere refolosite intre tick-uri
+    std::vector<int> stationary; // pe celula de incarcare si nu se misca
+    std::vector<int> diedNow;
+
+    long long updateEnergy(AgentType type, int begin, int end);
+    void moveDrones(const Map& map, int begin, int end);
+    void moveGround(AgentType type, const Map& map, int begin, int end, IPathfinder* pf);
+    void handleArrival(int i, const Map& map);
+
+    friend class Agent;
 
-class AgentFactory {
 public:
-    static std::unique_ptr<Agent> create(AgentType type, int id, int x, int y);
+    Fleet() : typeOffset{0, 0, 0, 0}, pathfinder(nullptr), trace(nullptr) {}
+
+    // Creeaza agentii la baza; id-urile urmeaza ordinea drone, roboti, scutere
+    void init(int drones, int robots, int scooters, Point base);
+    void setPathfinder(IPathfinder* pf) { pathfinder = pf; }
+    void setTrace(TraceWriter* writer) { trace = writer; }
+
+    // Un tick pentru agentii din sloturile [begin, end): incarcare, consum si
+    // deplasare. Fiecare agent isi modifica doar slotul propriu, deci
+    // intervale disjuncte pot rula pe thread-uri diferite, fiecare cu
+    // pathfinder-ul lui (nullptr = BFS implicit). Rezultatul nu depinde de
+    // impartire: costurile sunt intregi, iar bateria se calculeaza per agent.
+    FleetTickTotals updateRange(const Map& map, int begin, int end, IPathfinder* pf);
+    // Sloturile agentilor morti la ultimul tick, in ordine crescatoare
+    void collectDied(std::vector<int>& died) const;
+    IPathfinder* getPathfinder() const { return pathfinder; }
+
+    // Elibereaza pachetul fara sa schimbe starea (folosit la decesul agentului)
+    void releasePackage(int slot);
+
+    int size() const { return (int)ids.size(); }
+    int countOfType(AgentType type) const { return typeOffset[type + 1] - typeOffset[type]; }
+    int countAlive() const;
+    int countAlive(AgentType type) const;
+    Agent* get(int slot) { return &handles[slot]; }
+    const Agent* get(int slot) const { return &handles[slot]; }
 };
+
+inline int Agent::getId() const { return fleet->ids[slot]; }
+inline AgentType Agent::getType() const { return fleet->types[slot]; }
+inline AgentState Agent::getState() const { return fleet->states[slot]; }
+inline Point Agent::getPosition() const { return {fleet->posX[slot], fleet->posY[slot]}; }
+inline Point Agent::getTarget() const { return {fleet->targetX[slot], fleet->targetY[slot]}; }
+inline float Agent::getBattery() const { return fleet->battery[slot]; }
+inline float Agent::getBatteryPercentage() const {
+    return (getBattery() / getAgentSpec(getType()).maxBattery) * 100.0f;
+}
+inline Package* Agent::getPackage() const { return fleet->packages[slot]; }
+inline void Agent::setState(AgentState newState) { fleet->states[slot] = newState; }
+
 #endif
@@ -0,0 +1,13 @@
+#ifndef ALLOCCOUNT_H
+#define ALLOCCOUNT_H
+
+#include <cstddef>
+
+// Contor de alocari pe heap (operator new global), per thread. Folosit de
+// benchmark pentru a raporta alocarile per simulare. Numararea inlocuieste
+// operatorii globali new/delete, deci exista doar in build-urile cu
+// COUNT_ALLOCATIONS=1; altfel contorul ramane 0.
+bool allocationCountingEnabled();
+size_t getThreadAllocationCount();
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Alocator monoton: memoria se ia din blocuri mari si nu se elibereaza
+// individual, ci toata odata (release) sau pana la un marcaj (rewind).
+// Potrivit pentru obiecte care traiesc cat o simulare si pentru scratch-ul
+// unui tick. Nu este thread-safe; fiecare simulare are arena ei.
+class Arena {
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    // Obiect cu destructor netrivial creat in arena; distrus la release
+    struct Finalizer {
+        void (*destroy)(void*);
+        void* object;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<Finalizer> finalizers;
+    size_t current;   // blocul din care alocam
+    size_t offset;    // primul octet liber din blocul curent
+    size_t blockSize;
+
+    void* allocateSlow(size_t size, size_t align);
+
+    template <typename T>
+    static void destroyObject(void* object) { static_cast<T*>(object)->~T(); }
+
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    // Pozitia curenta, pentru eliberarea scratch-ului cu rewind()
+    struct Marker {
+        size_t block;
+        size_t offset;
+        size_t finalizers;
+    };
+
+    explicit Arena(size_t _blockSize = DEFAULT_BLOCK_SIZE)
+        : current(0), offset(0), blockSize(_blockSize) {}
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // `align` cel mult alignof(std::max_align_t)
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        if (!blocks.empty()) {
+            size_t aligned = (offset + align - 1) & ~(align - 1);
+            if (aligned + size <= blocks[current].size) {
+                offset = aligned + size;
+                return blocks[current].data + aligned;
+            }
+        }
+        return allocateSlow(size, align);
+    }
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Construieste un T in arena; destructorul ruleaza la release/rewind
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            finalizers.push_back({&destroyObject<T>, object});
+        }
+        return object;
+    }
+
+    Marker mark() const { return {current, offset, finalizers.size()}; }
+    void rewind(const Marker& marker);
+
+    // Distruge obiectele create si pastreaza blocurile pentru refolosire
+    void release();
+
+    size_t bytesReserved() const;
+};
+
+// Adaptor STL: containerele cu ArenaAllocator isi iau memoria din arena.
+// deallocate nu face nimic; memoria revine la release/rewind.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena* _arena) : arena(_arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return arena->allocateArray<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
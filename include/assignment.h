@@ -0,0 +1,41 @@
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+#include <vector>
+
+// Muchie candidat agent -> pachet (indici locali) cu castigul ei
+struct AssignmentEdge {
+    int agent;
+    int package;
+    double weight;
+};
+
+// Cuplaj de pondere maxima pe graful bipartit agenti x pachete, rezolvat ca
+// flux de cost minim (drumuri minime succesive cu potentiale, Dijkstra).
+// Se opreste cand niciun drum de augmentare nu mai creste castigul total.
+// Buffer-ele interne se refolosesc intre apeluri.
+class AssignmentSolver {
+private:
+    struct Arc {
+        int to;
+        int rev;      // indexul arcului invers in lista lui `to`
+        int cap;
+        double cost;
+        int edge;     // indexul muchiei candidat, -1 pentru arcele sursa/destinatie
+    };
+
+    std::vector<std::vector<Arc>> graph;
+    std::vector<double> potential;
+    std::vector<double> dist;
+    std::vector<int> prevNode;
+    std::vector<int> prevArc;
+
+    void addArc(int from, int to, double cost, int edge);
+
+public:
+    // Intoarce indicii muchiilor alese (fiecare agent si pachet cel mult o data)
+    std::vector<int> solve(int numAgents, int numPackages,
+                           const std::vector<AssignmentEdge>& edges);
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// Benchmark-uri tintite pe componente, separate de --benchmark (simulari complete)
+
+// BFS vs A* vs JPS pe harti deschise si aglomerate: noduri expandate si ns/cautare
+void runPathfindingBenchmark();
+
+// Greedy vs cuplaj optim in HiveMind pe flote de 10, 100 si 1000 de agenti.
+// Ambele moduri ruleaza aceleasi scenarii din corpusul `seedBase`.
+void runAssignmentBenchmark(unsigned long long seedBase);
+
+// Generatorul cu respingere vs cel conex din constructie, pe harti tot mai mari
+void runMapGenerationBenchmark();
+
+// Scalarea cu dimensiunea problemei: scari separate pentru harta (20..2000),
+// flota (6..10000) si pachete (50..1000000). Per treapta: ticks/sec,
+// ns per agent-tick si memoria maxima (RSS). Cu tickThreads > 1, agentii
+// fiecarui tick se actualizeaza in paralel (Simulation::setTickThreads).
+void runScalingBenchmark(unsigned int tickThreads = 1);
+
+#endif
@@ -3,26 +3,29 @@
 
 #include <string>
 
-class Config {
-private:
-    static Config* instance;
-    Config(); // Constructor privat
-
-public:
+// Parametrii unui scenariu. Valoare simpla, citita o data si apoi copiata in
+// fiecare simulare, deci un proces poate rula in paralel scenarii cu harti
+// si flote diferite fara stare globala.
+struct ScenarioConfig {
     // Initializate cu 0 pentru a garanta ca nu exista valori hardcodate
-    int mapHeight;
-    int mapWidth;
-    int maxTicks;
-    int maxStations;
-    int clientsCount;
-    int dronesCount;
-    int robotsCount;
-    int scootersCount;
-    int totalPackages;
-    int spawnFrequency;
+    int mapHeight = 0;
+    int mapWidth = 0;
+    int maxTicks = 0;
+    int maxStations = 0;
+    int clientsCount = 0;
+    int dronesCount = 0;
+    int robotsCount = 0;
+    int scootersCount = 0;
+    int totalPackages = 0;
+    int spawnFrequency = 0;
+    int packagesPerSpawn = 1; // optional, implicit 1
+
+    // Arunca runtime_error daca fisierul lipseste sau valorile nu descriu
+    // un scenariu care poate rula (harta goala, frecventa de generare 0)
+    static ScenarioConfig loadFromFile(const std::string& filename);
 
-    static Config* getInstance();
-    void loadFromFile(const std::string& filename);
+    // Descriere scurta pentru rapoarte, de exemplu "20x20 3/2/1"
+    std::string label() const;
 };
 
 #endif
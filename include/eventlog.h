@@ -0,0 +1,85 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Tipurile de evenimente din jurnalul simularii. Textul fiecaruia e
+// construit abia pe thread-ul de scriere, din argumentele numerice.
+enum LogEventType : uint8_t {
+    LOG_INIT_STARTED,      // -
+    LOG_INIT_READY,        // -
+    LOG_AGENTS_CREATED,    // numar agenti
+    LOG_PACKAGE_SPAWNED,   // id, reward, deadline
+    LOG_AGENT_DIED,        // id, tip, x, y
+    LOG_DELIVERED,         // pachet, agent, tip agent
+    LOG_DELIVERED_LATE,    // pachet, agent, tip agent, intarziere
+    LOG_SIM_STARTED,       // -
+    LOG_SIM_MAX_TICKS,     // max ticks
+    LOG_HEARTBEAT,         // tick
+    LOG_ALL_AGENTS_DEAD,   // -
+    LOG_SIM_FINISHED,      // -
+    LOG_SIM_DURATION,      // milisecunde
+    LOG_REPORT_SAVED       // -
+};
+
+// Inregistrare de dimensiune fixa, copiata in buffer fara alocari
+struct LogRecord {
+    int32_t tick;
+    LogEventType type;
+    int32_t args[4];
+};
+
+// Jurnal asincron: simularea (singurul producator) pune inregistrari intr-un
+// buffer circular fara lock-uri, iar un thread de fundal (singurul
+// consumator) le formateaza si le scrie in fisier in blocuri mari.
+// Daca bufferul e plin, producatorul asteapta; nu se pierde nimic.
+class AsyncLogger {
+private:
+    static const size_t CAPACITY = 1 << 14;   // putere a lui 2
+    static const size_t BATCH_BYTES = 1 << 16;
+
+    static const size_t CACHE_LINE = 64;
+
+    // Indicii celor doua thread-uri pe linii de cache separate (padding
+    // explicit: in C++14 `new` nu respecta alignas peste max_align_t)
+    std::vector<LogRecord> ring;
+    char padHead[CACHE_LINE];
+    std::atomic<size_t> head;   // urmatoarea inregistrare de citit (consumator)
+    char padTail[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail;   // urmatorul slot liber (producator)
+    char padStop[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<bool> stopping;
+
+    std::ofstream out;
+    std::string batch;
+    std::thread writer;
+
+    void writerLoop();
+    size_t drain();
+    void format(const LogRecord& record);
+
+public:
+    explicit AsyncLogger(const std::string& path);
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    bool isOpen() const { return out.is_open(); }
+
+    void push(const LogRecord& record) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        while (t - head.load(std::memory_order_acquire) >= CAPACITY) {
+            std::this_thread::yield();
+        }
+        ring[t & (CAPACITY - 1)] = record;
+        tail.store(t + 1, std::memory_order_release);
+    }
+};
+
+#endif
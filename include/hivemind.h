@@ -2,6 +2,9 @@
 #define HIVEMIND_H
 
 #include "utils.h"
+#include "assignment.h"
+#include "arena.h"
+#include "profiler.h"
 #include <vector>
 #include <memory>
 
@@ -45,27 +48,64 @@ struct Package {
     }
 };
 
+// Cum se aleg perechile agent-pachet dupa ce au fost scorate
+enum AssignmentMode {
+    ASSIGN_GREEDY,   // descrescator dupa scor, primul venit
+    ASSIGN_OPTIMAL   // cuplaj de scor total maxim (flux de cost minim)
+};
+
+// Index spatial al pachetelor in asteptare, pe galeti de BUCKET_SIZE x BUCKET_SIZE
+// celule dupa destinatie. Refolosit intre tick-uri: golirea atinge doar
+// galetile folosite.
+class PackageGrid {
+private:
+    static const int BUCKET_SIZE = 8;
+    
+    int bucketsX, bucketsY;
+    std::vector<std::vector<Package*>> buckets;
+    std::vector<int> usedBuckets;
+    
+public:
+    PackageGrid() : bucketsX(0), bucketsY(0) {}
+    
+    void reset(int width, int height);
+    void insert(Package* package);
+    
+    // Apeleaza fn(Package*) pentru pachetele cu destinatia in patratul
+    // [center - radius, center + radius] pe ambele axe
+    template <typename Fn>
+    void forEachInBox(const Point& center, double radius, Fn fn) const;
+};
+
 class HiveMind {
 private:
+    // Partile scorului care nu depind de tick: raman valabile cat timp
+    // agentul nu se misca si nu i se schimba bateria
+    struct ScoreTerms {
+        double grossProfit = 0.0;     // reward - costul estimat
+        int deliveryTime = 0;
+        float batteryRisk = 0.0f;     // 0 = sigur, 1 = riscant
+        double distanceFactor = 1.0;
+    };
+    
     // Structură internă pentru scorul atribuirilor
     struct AssignmentScore {
-        Agent* agent;
-        Package* package;
-        double score;
-        double estimatedProfit;
-        int estimatedDeliveryTime;
-        int energyRisk;
+        int agentId;
+        int packageId;
+        double score;        // recalculat din `terms` la fiecare planificare
+        ScoreTerms terms;
         
-        AssignmentScore(Agent* a, Package* p, double s, double ep, int edt, int er)
-            : agent(a), package(p), score(s), estimatedProfit(ep), 
-              estimatedDeliveryTime(edt), energyRisk(er) {}
+        AssignmentScore(int a, int p, const ScoreTerms& t)
+            : agentId(a), packageId(p), score(0.0), terms(t) {}
         
         bool operator<(const AssignmentScore& other) const {
             return score < other.score;
         }
     };
     
-   
+public:
+    // Ponderile scorului de atribuire si pragurile de baterie; publice pentru
+    // --sweep, care le cauta pe un corpus de scenarii
     struct OptimizationParams {
         double profitWeight = 0.50;      // Importanța profitului imediat
         double safetyWeight = 0.30;      // Importanța siguranței bateriei
@@ -77,34 +117,104 @@ private:
         int safeBatteryMargin = 30;          // Marja de siguranță (%)
     };
     
+private:
     OptimizationParams params;
+    AssignmentMode assignmentMode = ASSIGN_GREEDY;
+    
+    // Starea unui agent la ultima planificare, pentru detectia evenimentelor
+    struct AgentSnapshot {
+        bool known = false;
+        bool alive = false;
+        bool free = false;     // viu si fara pachet
+        Point position = {-1, -1};
+        float battery = -1.0f;
+    };
+    
+    // Planificare incrementala: partile fezabile ale scorurilor raman in cache
+    // intre tick-uri si se recalculeaza doar perechile atinse de un eveniment
+    // (pachet nou sau revenit in coada, agent liber, agent mutat sau cu alta
+    // baterie, agent mort). Termenii care depind de tick se adauga la fiecare
+    // planificare, deci rezultatul e acelasi ca la rescorarea completa.
+    std::vector<AssignmentScore> cachedScores;
+    std::vector<AgentSnapshot> agentSnapshots; // dupa id agent
+    std::vector<char> packageWasPending;       // dupa id pachet
+    std::vector<char> agentDirty;
+    std::vector<char> packageDirty;
+    std::vector<Agent*> agentById;
+    std::vector<Package*> packageById;
+    size_t lastAliveAgents = 0;
+    PackageGrid pendingGrid;
+    std::vector<Package*> dirtyPackages;
+    // Pachetele abandonate de agentii trimisi la incarcat in tick-ul curent;
+    // se pot reatribui imediat, desi Simulation le muta in coada abia dupa update()
+    std::vector<Package*> releasedPackages;
+    
+    // Buffere refolosite intre tick-uri
+    std::vector<AssignmentScore> allScores;
+    std::vector<int> chosenScores;
+    std::vector<AssignmentEdge> candidateEdges;
+    AssignmentSolver solver;
+    
+    // Scratch pentru tablourile temporare ale unui tick, golit la finalul update()
+    Arena& scratch;
+    
+    PhaseProfiler* profiler = nullptr;   // nullptr = fara masuratori
+    void lap(ProfilePhase phase) { if (profiler) profiler->lap(phase); }
     
     // Metode helper private
-    Point findNearestChargingPoint(const Point& position, const Map& map) const;
+    double travelDistance(const Agent* agent, const Point& from, const Point& to,
+                          const Map& map) const;
+    Point nearestCharger(const Agent* agent, const Point& from, const Map& map) const;
     bool needsCharging(const Agent* agent, const Point& destination, const Map& map) const;
-    int estimateDeliveryTime(const Agent* agent, const Point& destination) const;
+    int estimateDeliveryTime(const Agent* agent, const Point& destination, const Map& map) const;
     double estimateDeliveryCost(const Agent* agent, int deliveryTime) const;
-    double calculateAssignmentScore(Agent* agent, Package* package, 
-                                   const Map& map, int currentTick) const;
+    double reachableRadius(const Agent* agent, double distToPickup) const;
+    // Partile scorului independente de tick, cu distanta agent -> baza
+    // calculata o data per agent, in afara buclei pe pachete. false daca
+    // livrarea nu e fezabila (autonomie sau baterie critica).
+    bool scoreTerms(const Agent* agent, const Package* package, const Map& map,
+                    double distToPickup, ScoreTerms& terms) const;
+    // Scorul final: termenii din cache plus cei care depind de tick
+    double combineScore(const Agent* agent, const Package* package, const ScoreTerms& terms,
+                        int currentTick) const;
     
     // Strategii specifice
-    void handleLowBatteryAgents(std::vector<Agent*>& agents, const Map& map);
-    void assignPackages(std::vector<Agent*>& agents, std::vector<Package*>& packages,
+    void handleLowBatteryAgents(Span<Agent*> agents, const Map& map);
+    void assignPackages(Span<Agent*> agents, Span<Package*> packages,
                        const Map& map, int currentTick);
-    void optimizeIdleAgents(std::vector<Agent*>& agents, const Map& map);
+    void optimizeIdleAgents(Span<Agent*> agents, const Map& map);
+    bool collectEvents(Span<Agent*> agents, Span<Package*> packages);
+    void refreshScores(Span<Agent*> agents, Span<Package*> packages, const Map& map);
+    void addScore(Agent* agent, Package* package, const Map& map, double distToPickup);
+    void selectGreedy();
+    void selectOptimal();
     
 public:
-    HiveMind() = default;
+    explicit HiveMind(Arena& _scratch) : scratch(_scratch) {}
     
     // Setează parametrii de optimizare
     void setOptimizationParams(const OptimizationParams& newParams) {
         params = newParams;
     }
     
-    // Metoda principală - apelată la fiecare tick
-    void update(std::vector<Agent*>& agents, std::vector<Package*>& packages,
+    void setAssignmentMode(AssignmentMode mode) { assignmentMode = mode; }
+    void setProfiler(PhaseProfiler* _profiler) { profiler = _profiler; }
+    
+    // Uita starea planificarii (pentru o simulare noua); bufferele isi pastreaza capacitatea
+    void reset();
+    
+    // Metoda principală - apelată la fiecare tick. `agents` contine doar
+    // agentii vii, `packages` doar pachetele care asteapta un agent. Pachetele
+    // eliberate de agentii cu baterie critica se adauga la planificarea
+    // aceluiasi tick.
+    void update(Span<Agent*> agents, Span<Package*> packages,
                 const Map& map, int currentTick);
     
+    // Scorul perechii agent-pachet (mai mare = mai buna); negativ daca
+    // livrarea nu e fezabila. Nu modifica starea planificarii.
+    double calculateAssignmentScore(Agent* agent, Package* package, 
+                                   const Map& map, int currentTick) const;
+    
     // Getter pentru parametri
     const OptimizationParams& getParams() const { return params; }
 };
@@ -1,10 +1,16 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <deque>
 #include <vector>
 #include <string>
+#include <iosfwd>
+#include <cstdint>
+#include <random>
 #include "utils.h"
 
+struct ScenarioConfig;
+
 #define CELL_EMPTY   '.'
 #define CELL_WALL    '#'
 #define CELL_BASE    'B'
@@ -16,18 +22,77 @@ private:
     int height, width;
     std::vector<std::string> grid;
 
+    // Bitboard cu celulele accesibile (64 celule pe cuvant). Fiecare rand
+    // incepe cu un cuvant de padding gol, iar sus si jos exista cate un rand
+    // gol, deci vecinii celulelor de pe margine se citesc fara verificari.
+    int wordsPerRow;
+    std::vector<uint64_t> walkable;
+
+    // Campuri de distanta BFS, cate unul pentru fiecare punct de interes
+    // (baza, clienti, statii). Harta e statica dupa generare, deci le
+    // calculam o singura data si agentii doar coboara pe gradient.
+    std::vector<Point> fieldTargets;
+    std::vector<int> fieldOfCell;   // per celula: indexul campului sau -1
+    std::vector<int> distanceFields; // fieldTargets.size() * height * width
+
+    // Tabele complete intre punctele de interes (N x N, N = fieldTargets):
+    // drum exact pe grid pentru agentii de sol si distanta euclidiana pentru drone.
+    std::vector<int> poiGroundDistances;
+    std::vector<double> poiAirDistances;
+
+    // Per celula: cel mai apropiat punct de incarcare (baza sau statie) dupa
+    // drumul real, din BFS multi-sursa. Celulele fara drum (ziduri, zone
+    // izolate) primesc cel mai apropiat punct in distanta Manhattan.
+    std::vector<Point> nearestCharger;
+    // Acelasi tabel pentru agentii aerieni: distanta Manhattan, peste ziduri
+    std::vector<Point> nearestAirCharger;
+
+    void buildFieldRange(size_t first, size_t last);
+    void buildNearestChargers();
+
 public:
     int startX, startY; 
     std::vector<Point> clients;
     std::vector<Point> stations;
 
-    Map() : height(0), width(0), startX(0), startY(0) {}
+    Map() : height(0), width(0), wordsPerRow(0), startX(0), startY(0) {}
     
     void init(int h, int w);
     void setCell(int x, int y, char type);
     char getCell(int x, int y) const;
     bool isValidCoord(int x, int y) const;
     void print() const;
+
+    // Valid pentru x in [-1, width] si y in [-1, height], fara bounds check
+    bool isWalkable(int x, int y) const {
+        int bit = x + 64;
+        return (walkable[(y + 1) * wordsPerRow + (bit >> 6)] >> (bit & 63)) & 1;
+    }
+    void floodFill(const Point& from, std::vector<uint64_t>& reached) const;
+    bool isReached(const std::vector<uint64_t>& reached, const Point& p) const;
+    bool allReachableFrom(const Point& from, const std::vector<Point>& targets) const;
+
+    void buildDistanceFields();
+    
+    // Format binar: harta impreuna cu datele de drum precalculate, ca o
+    // incarcare sa nu refaca nici generarea, nici BFS-urile
+    void write(std::ostream& out) const;
+    void read(std::istream& in);
+    int getFieldIndex(const Point& target) const;
+    int getFieldDistance(int field, const Point& from) const;
+    bool nextStepToward(const Point& from, const Point& target, Point& next) const;
+
+    int getPoiCount() const { return (int)fieldTargets.size(); }
+    int getPoiGroundDistance(int from, int to) const;
+    double getPoiAirDistance(int from, int to) const;
+    int getGroundDistance(const Point& from, const Point& to) const;
+    double getAirDistance(const Point& from, const Point& to) const;
+    Point getNearestCharger(const Point& from) const {
+        return nearestCharger[from.y * width + from.x];
+    }
+    Point getNearestAirCharger(const Point& from) const {
+        return nearestAirCharger[from.y * width + from.x];
+    }
     
     int getHeight() const { return height; }
     int getWidth() const { return width; }
@@ -38,17 +103,64 @@ public:
 
 class IMapGenerator {
 public:
-    virtual void generate(Map& map) = 0;
+    virtual void generate(Map& map, const ScenarioConfig& config) = 0;
+    virtual void seed(unsigned int value) = 0;
     virtual ~IMapGenerator() {}
 };
 
-class ProceduralMapGenerator : public IMapGenerator {
+// Baza comuna: generatorul aleator si plasarea bazei, clientilor si statiilor
+class RandomMapGenerator : public IMapGenerator {
 public:
-    void generate(Map& map) override;
+    RandomMapGenerator();
+    
+    void seed(unsigned int value) override { rng.seed(value); }
+    
+    // Fara campuri de distanta harta nu e gata de simulare; folosit doar
+    // cand apelantul le construieste separat (benchmark-ul de generare)
+    void setBuildDistanceFields(bool enabled) { buildFields = enabled; }
+    
+    // Fractiunea din harta trasa ca ziduri. Pozitiile se trag cu repetitie si
+    // doar celulele goale devin ziduri, deci densitatea reala iese mai mica.
+    static constexpr double WALL_DENSITY = 0.2;
+    
+protected:
+    std::mt19937 rng;
+    bool buildFields = true;
     
-private:
-    bool validateMap(const Map& map);
     int getRandom(int min, int max);
+    void placePointsOfInterest(Map& map, int clientsCount, int stationsCount);
+};
+
+// Ziduri aleatoare pe 20% din harta; harta se arunca si se regenereaza
+// (pana la 2000 de incercari) daca un client sau o statie nu e accesibila din baza
+class ProceduralMapGenerator : public RandomMapGenerator {
+public:
+    void generate(Map& map, const ScenarioConfig& config) override;
+    int getLastAttempts() const { return lastAttempts; }
+    
+    // true daca toti clientii si toate statiile sunt accesibile din baza
+    bool validateMap(const Map& map);
+    
+private:
+    int lastAttempts = 0;
+};
+
+// Aceeasi distributie de ziduri, fara reincercari: dupa plasarea zidurilor,
+// componenta bazei se afla cu flood fill-ul pe bitboard, iar fiecare client
+// sau statie din afara ei e legat de ea stergand numarul minim de ziduri.
+// Harta iese valida dintr-o singura trecere.
+class ConnectedMapGenerator : public RandomMapGenerator {
+public:
+    void generate(Map& map, const ScenarioConfig& config) override;
+    
+private:
+    // Buffere refolosite intre generari
+    std::vector<uint64_t> reached; // componenta bazei
+    std::vector<int> dist;
+    std::vector<int> prev;
+    std::deque<int> frontier;
+    
+    void carvePathToBase(Map& map, const Point& from);
 };
 
 #endif
@@ -0,0 +1,31 @@
+#ifndef MAPCORPUS_H
+#define MAPCORPUS_H
+
+#include "map.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Set de harti generate o singura data si apoi doar citite. Hartile sunt
+// imutabile dupa generare (inclusiv campurile de distanta), deci oricate
+// simulari de pe oricate thread-uri le pot folosi simultan fara copiere.
+class MapCorpus {
+private:
+    std::vector<std::shared_ptr<const Map>> maps;
+
+public:
+    // Genereaza `count` harti in paralel dupa `config`. Harta k depinde doar
+    // de config, seedBase si k.
+    static MapCorpus generate(const ScenarioConfig& config, int count, unsigned long long seedBase,
+                              unsigned int numThreads);
+
+    // Fisier binar: antet + hartile cu datele de drum precalculate
+    void save(const std::string& path) const;
+    static MapCorpus load(const std::string& path);
+
+    int size() const { return (int)maps.size(); }
+    bool empty() const { return maps.empty(); }
+    const std::shared_ptr<const Map>& get(int index) const { return maps[index % maps.size()]; }
+};
+
+#endif
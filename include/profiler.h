@@ -0,0 +1,106 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Fazele masurate la fiecare tick. Sub-pasii HiveMind se afla in interiorul
+// lui PHASE_HIVEMIND, iar toate fazele de la PHASE_SPAWN incolo in PHASE_TICK.
+enum ProfilePhase {
+    PHASE_TICK,
+    PHASE_SPAWN,
+    PHASE_HIVEMIND,
+    PHASE_LOW_BATTERY,     // HiveMind::handleLowBatteryAgents
+    PHASE_ASSIGN,          // HiveMind::assignPackages
+    PHASE_OPTIMIZE_IDLE,   // HiveMind::optimizeIdleAgents
+    PHASE_SYNC_ASSIGNED,   // syncPackageLists dupa HiveMind::update
+    PHASE_UPDATE_AGENTS,
+    PHASE_DELIVERIES,
+    PHASE_SYNC_DELIVERED,  // syncPackageLists dupa processDeliveries
+    PHASE_CHECK_STATUS,
+    PHASE_COUNT
+};
+
+const char* profilePhaseName(ProfilePhase phase);
+
+// Histograma de latente in nanosecunde, cu 4 sub-intervale pe fiecare putere
+// a lui 2 (eroare relativa sub 25%). Dimensiune fixa, fara alocari la
+// inregistrare; histogramele thread-urilor se aduna cu merge().
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 2;
+    static const int BUCKETS = 64 << SUB_BITS;
+
+    LatencyHistogram() { clear(); }
+
+    void clear();
+    void record(uint64_t ns) {
+        buckets[bucketOf(ns)]++;
+        count++;
+        total += ns;
+        if (ns > maxValue) maxValue = ns;
+    }
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const { return count; }
+    uint64_t getTotal() const { return total; }
+    uint64_t getMax() const { return maxValue; }
+    double getMean() const { return count ? (double)total / count : 0.0; }
+    // Limita superioara a sub-intervalului in care cade percentila p (0..100)
+    uint64_t percentile(double p) const;
+
+private:
+    uint64_t buckets[BUCKETS];
+    uint64_t count;
+    uint64_t total;
+    uint64_t maxValue;
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < (1u << SUB_BITS)) return (int)ns;
+        int msb = 63 - __builtin_clzll(ns);
+        int sub = (int)(ns >> (msb - SUB_BITS)) & ((1 << SUB_BITS) - 1);
+        return ((msb - SUB_BITS + 1) << SUB_BITS) | sub;
+    }
+    static uint64_t bucketUpperBound(int bucket);
+};
+
+// Cronometru pe faze: lap(faza) atribuie fazei timpul scurs de la ultimul
+// lap(), deci fazele consecutive costa o singura citire de ceas fiecare.
+// Un profiler per simulare/thread; fara sincronizare. Fiecare masuratoare
+// include si o citire de ceas (~30 ns pe steady_clock), deci fazele foarte
+// scurte apar usor supraestimate.
+class PhaseProfiler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static uint64_t now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count();
+    }
+
+    // Incepe o masuratoare noua fara sa atribuie timpul scurs vreunei faze
+    void start() { last = now(); }
+    void lap(ProfilePhase phase) {
+        uint64_t t = now();
+        phases[phase].record(t - last);
+        last = t;
+    }
+    // Timpul ultimului lap()/start(), pentru fazele care le cuprind pe altele
+    uint64_t lastLap() const { return last; }
+    void record(ProfilePhase phase, uint64_t ns) { phases[phase].record(ns); }
+
+    void clear();
+    void merge(const PhaseProfiler& other);
+    const LatencyHistogram& get(ProfilePhase phase) const { return phases[phase]; }
+
+    // Tabel cu numarul de masuratori, media, p50/p90/p99, maximul si ponderea
+    // din timpul total al tick-urilor
+    void print(std::ostream& out) const;
+
+private:
+    LatencyHistogram phases[PHASE_COUNT];
+    uint64_t last = 0;
+};
+
+#endif
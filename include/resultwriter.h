@@ -0,0 +1,57 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include "simulation.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scrie rezultatele rularilor intr-un singur fisier, CSV sau JSON lines
+// (dupa extensia .jsonl / .json). Thread-urile benchmark-ului predau loturi
+// de rezultate prin submit(); formatarea si scrierea se fac pe un singur
+// thread de fundal, in blocuri mari. Ordinea liniilor urmeaza ordinea
+// predarii, deci fiecare linie contine indexul scenariului.
+class ResultWriter {
+public:
+    enum Format { FORMAT_CSV, FORMAT_JSONL };
+
+    explicit ResultWriter(const std::string& path);
+    ~ResultWriter();   // scrie tot ce a ramas si inchide fisierul, fara verificare
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    bool isOpen() const { return out.is_open(); }
+    Format getFormat() const { return format; }
+
+    // Muta rezultatele din `batch` in coada; `batch` ramane gol, cu capacitatea pastrata
+    void submit(std::vector<SimulationResult>& batch);
+
+    // Asteapta scrierea ultimelor rezultate si inchide fisierul; arunca
+    // runtime_error daca vreo scriere a esuat (de exemplu disc plin)
+    void close();
+
+private:
+    static const size_t WRITE_BYTES = 1 << 16;
+
+    Format format;
+    std::string path;
+    std::ofstream out;
+    std::string buffer;
+
+    std::mutex lock;
+    std::condition_variable ready;
+    std::vector<SimulationResult> queued;   // protejat de `lock`
+    bool stopping = false;
+    std::thread writer;
+    bool writeFailed = false;   // scris doar de `writer`, citit dupa join
+
+    void stop();
+    void writerLoop();
+    void append(const SimulationResult& r);
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool cu furt de lucru pentru loturi de iteratii independente.
+// Intervalul [0, total) se imparte in loturi de `chunk` iteratii, distribuite
+// initial in blocuri contigue pe cozile thread-urilor. Fiecare thread ia din
+// spatele cozii proprii; cand ramane fara lucru fura din fata cozii altuia.
+// Nu apar loturi noi in timpul rularii, deci un thread care nu gaseste nimic
+// de furat poate termina.
+class WorkStealingScheduler {
+public:
+    // body(worker, begin, end) ruleaza iteratiile [begin, end) pe thread-ul `worker`
+    typedef std::function<void(int, int, int)> Body;
+
+    struct WorkerStats {
+        double busySeconds = 0.0;   // timp petrecut in body
+        double idleSeconds = 0.0;   // restul pana la terminarea ultimului thread
+        long long chunksRun = 0;
+        long long chunksStolen = 0;
+    };
+
+    explicit WorkStealingScheduler(unsigned int numThreads);
+    ~WorkStealingScheduler();
+
+    // Porneste thread-urile si revine imediat; wait() asteapta terminarea
+    void start(int total, int chunk, Body body);
+    void wait();
+
+    unsigned int getThreadCount() const { return (unsigned int)queues.size(); }
+    const std::vector<WorkerStats>& getStats() const { return stats; }
+
+private:
+    struct Range {
+        int begin;
+        int end;
+    };
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<WorkerStats> stats;
+    std::vector<std::chrono::steady_clock::time_point> finishTimes;
+    std::chrono::steady_clock::time_point runStart;
+    std::vector<std::thread> threads;
+    Body body;
+
+    bool popLocal(int worker, Range& range);
+    bool steal(int worker, Range& range);
+    void workerLoop(int worker);
+};
+
+// Pool persistent pentru faze scurte, repetate la fiecare tick: thread-urile
+// sunt pornite o singura data si asteapta urmatoarea faza, pentru ca
+// pornirea lor la fiecare tick ar costa mai mult decat faza insasi.
+// run(task) executa task(part) pentru fiecare part din [0, size()); partea 0
+// ruleaza pe thread-ul apelant, iar run() revine dupa ce toate s-au terminat.
+class ForkJoinPool {
+public:
+    typedef std::function<void(int)> Task;
+
+    explicit ForkJoinPool(unsigned int numParts);
+    ~ForkJoinPool();
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    unsigned int size() const { return (unsigned int)threads.size() + 1; }
+    void run(const Task& task);
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex lock;
+    std::condition_variable wake;       // faza noua sau oprire
+    std::condition_variable finished;   // ultima parte s-a terminat
+    const Task* current;
+    unsigned long long generation;      // numarul fazei curente
+    int pending;                        // parti neterminate din faza curenta
+    bool stopping;
+
+    void workerLoop(int part);
+};
+
+#endif
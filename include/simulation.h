@@ -5,19 +5,88 @@
 #include "map.h"
 #include "agents.h"
 #include "hivemind.h"
+#include "arena.h"
+#include "eventlog.h"
+#include "trace.h"
+#include "profiler.h"
+#include "scheduler.h"
 #include <vector>
 #include <fstream>
 #include <string>
 #include <memory> // Pentru unique_ptr
+#include <random>
+
+// Rezultatul unei rulari, copiat prin valoare; nu depinde de fisiere
+struct SimulationResult {
+    int scenario = 0;
+    unsigned int seed = 0;
+    int ticksRun = 0;
+    int totalTicks = 0;
+    int mapWidth = 0;
+    int mapHeight = 0;
+
+    int agentsInitial = 0;
+    int agentsAlive = 0;
+    int agentsLost = 0;
+    int agentsOfType[3] = {0, 0, 0};    // dupa AgentType
+    int aliveOfType[3] = {0, 0, 0};
+
+    int packagesGenerated = 0;
+    int packagesDelivered = 0;
+    int packagesFailed = 0;
+
+    long long revenue = 0;
+    long long costs = 0;
+    long long penalties = 0;
+    long long profit = 0;
+
+    double successRate() const {
+        return packagesGenerated ? packagesDelivered * 100.0 / packagesGenerated : 0.0;
+    }
+};
 
 class Simulation {
 private:
-    // Folosim unique_ptr pentru management automat de memorie
-    std::unique_ptr<Map> map;
-    std::vector<std::unique_ptr<Agent>> agents;
-    std::vector<std::unique_ptr<Package>> packages;
-    std::unique_ptr<HiveMind> hiveMind;
-    std::unique_ptr<ProceduralMapGenerator> mapGenerator;
+    // Memoria simularii: harta, planificatorul, generatorul, pachetele si
+    // listele lor stau in `arena` si se elibereaza odata cu simularea.
+    // `tickScratch` se goleste dupa fiecare tick. Declarate primele, ca sa
+    // fie distruse ultimele.
+    Arena tickScratch;
+    Arena arena;
+    
+    const ScenarioConfig config;   // copia proprie, nu se schimba dupa constructie
+    
+    Map* ownMap;                         // generata de simulare
+    std::shared_ptr<const Map> sharedMap; // din corpus, daca e setata
+    const Map* map;                      // harta folosita la rulare
+    Fleet fleet;
+    ArenaVector<Package*> packages;
+    HiveMind* hiveMind;
+    IMapGenerator* mapGenerator;
+    Arena::Marker runStart;   // in arena, tot ce urmeaza apartine unei singure rulari
+    std::mt19937 rng;         // generarea pachetelor
+    unsigned int seed;        // ultimul seed, pentru urma binara
+    int scenario;             // indexul dat la initialize()
+    std::string reportPath;   // gol = fara raport la finalul rularii
+    TraceWriter* trace;       // nullptr = fara urma
+    PhaseProfiler* profiler;  // nullptr = fara masurarea fazelor
+    PathfinderType pathfinderType;
+    std::unique_ptr<IPathfinder> pathfinder; // pentru tintele fara camp de distanta
+    
+    // Actualizarea paralela a agentilor (optionala): partea p a flotei
+    // foloseste tickPathfinders[p], fiindca pathfinder-ele au stare proprie
+    std::unique_ptr<ForkJoinPool> tickPool;
+    std::vector<std::unique_ptr<IPathfinder>> tickPathfinders;
+    std::vector<FleetTickTotals> tickPartials;
+    
+    std::vector<int> diedThisTick;
+    
+    // Liste active, actualizate la evenimente (generare, atribuire, livrare,
+    // deces), ca un tick sa coste proportional cu munca activa, nu cu istoricul
+    ArenaVector<Agent*> aliveAgents;
+    ArenaVector<Package*> pendingPackages;   // asteapta un agent
+    ArenaVector<Package*> inFlightPackages;  // atribuite, nelivrate inca
+    ArenaVector<Package*> finishedPackages;  // livrate
     
     // Timp și statistici
     int currentTick;
@@ -34,8 +103,8 @@ private:
     int agentsLost;
     int agentsAlive;
     
-    // Logging
-    std::ofstream logFile;
+    // Logging: inregistrari numerice, formatate si scrise pe thread-ul jurnalului
+    std::unique_ptr<AsyncLogger> logger;
     bool enableLogging;
     
     // Metode private
@@ -45,18 +114,66 @@ private:
     void updateAgents();
     void processDeliveries();
     void checkAgentStatus();
-    void logEvent(const std::string& message);
-    void saveStatistics();
+    void syncPackageLists();
+    void logEvent(LogEventType type, int a0 = 0, int a1 = 0, int a2 = 0, int a3 = 0) {
+        if (logger) logger->push({currentTick, type, {a0, a1, a2, a3}});
+    }
+    void lap(ProfilePhase phase) { if (profiler) profiler->lap(phase); }
     
 public:
-    Simulation(bool enableLog = false);
+    // Sub acest numar de agenti, sincronizarea thread-urilor costa mai mult
+    // decat castiga, asa ca tick-ul ramane pe un thread
+    static const int PARALLEL_TICK_MIN_AGENTS = 512;
+    
+    Simulation(const ScenarioConfig& _config, bool enableLog = false,
+               PathfinderType pathfinderType = PATHFINDER_BFS);
     ~Simulation();
     
     // Metode principale
-    void initialize();
+    void initialize(int scenario = 0);
+    // Readuce simularea la starea de dinainte de initialize() si fixeaza
+    // seed-ul pentru harta si pachete. Harta, flota si planificatorul sunt
+    // refolosite, cu bufferele lor; urmeaza initialize() + run().
+    void reset(unsigned int seed);
+    
+    // Seed-ul scenariului `index` dintr-un corpus: depinde doar de baza si
+    // de index, nu de thread-ul sau ordinea in care ruleaza simularea
+    static unsigned int scenarioSeed(unsigned long long seedBase, int index);
+    
+    // Foloseste o harta gata generata in locul generarii proprii, pana la
+    // urmatorul reset(). Harta e doar citita, deci poate fi partajata.
+    void setSharedMap(std::shared_ptr<const Map> shared) { sharedMap = std::move(shared); }
+    
+    // Urma binara: evenimentele rularilor urmatoare se adauga in `writer`,
+    // fiecare precedata de TRACE_SIM_BEGIN cu indexul `scenario` dat la initialize()
+    void setTrace(TraceWriter* writer) { trace = writer; fleet.setTrace(writer); }
+    unsigned int getSeed() const { return seed; }
+    // Histogramele de latenta ale fazelor fiecarui tick se adauga in `_profiler`
+    void setProfiler(PhaseProfiler* _profiler) { profiler = _profiler; hiveMind->setProfiler(_profiler); }
+    // Actualizeaza agentii fiecarui tick pe `threads` thread-uri (inclusiv
+    // cel apelant), cand flota are cel putin PARALLEL_TICK_MIN_AGENTS agenti.
+    // Rezultatele, jurnalul si urma sunt identice cu rularea pe un thread.
+    void setTickThreads(unsigned int threads);
+    unsigned int getTickThreads() const { return tickPool ? tickPool->size() : 1; }
     void run();
+    // Un singur tick din run(), fara finalizarea rularii (penalizari, raport);
+    // false cand s-au terminat tick-urile sau agentii. Pentru microbenchmark-uri.
+    bool step();
     void printFinalReport() const;
     
+    // Rezultatul ultimei rulari, construit din contoare la cerere
+    SimulationResult getResult() const;
+    // Raportul text al rezultatului; arunca runtime_error daca fisierul nu poate fi creat
+    static void saveReport(const SimulationResult& result, const std::string& path);
+    // Daca e setat, run() scrie raportul aici la final (rularile normale);
+    // benchmark-ul il lasa gol si nu atinge sistemul de fisiere
+    void setReportPath(const std::string& path) { reportPath = path; }
+    void setAssignmentMode(AssignmentMode mode) { hiveMind->setAssignmentMode(mode); }
+    // Raman valabili si dupa reset(), pana la urmatorul apel
+    void setOptimizationParams(const HiveMind::OptimizationParams& params) {
+        hiveMind->setOptimizationParams(params);
+    }
+    
     // Getters pentru statistici
     long long getTotalProfit() const { return totalRevenue - totalCosts - totalPenalties; }
     int getPackagesDelivered() const { return packagesDelivered; }
@@ -65,6 +182,8 @@ public:
         return packages.empty() ? 0.0 : (packagesDelivered * 100.0) / packages.size(); 
     }
     int getAgentsAlive() const { return agentsAlive; }
+    int getTicksRun() const { return currentTick; }
+    const ScenarioConfig& getConfig() const { return config; }
 };
 
 #endif
@@ -0,0 +1,31 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "config.h"
+#include "mapcorpus.h"
+#include "agents.h"
+#include "hivemind.h"
+#include <string>
+#include <vector>
+
+// Cautare pentru HiveMind::OptimizationParams pe corpusul de scenarii al
+// benchmark-ului (aceleasi seed-uri pentru toti candidatii), in paralel pe
+// pool-ul cu furt de lucru. Rezultatul e frontul Pareto profit/supravietuire.
+struct SweepSettings {
+    int candidates = 64;             // in afara de parametrii impliciti, evaluati mereu
+    bool successiveHalving = true;   // altfel cautare aleatoare pe tot corpusul
+    int corpusSize = 1024;           // scenariile folosite in runda finala
+    unsigned long long seedBase = 0;
+    std::string specPath;            // intervalele parametrilor; gol = cele implicite
+    PathfinderType pathfinderType = PATHFINDER_BFS;
+    AssignmentMode assignmentMode = ASSIGN_GREEDY;
+    unsigned int numThreads = 1;
+};
+
+// Fisierul de intervale are cate o linie "NUME MIN MAX [log]", in stilul lui
+// simulation_setup.txt; variaza doar parametrii listati. NUME e un camp din
+// OptimizationParams (de exemplu profitWeight sau criticalBatteryThreshold).
+void runParameterSweep(const SweepSettings& settings, const std::vector<ScenarioConfig>& configs,
+                       const MapCorpus& maps);
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Urma binara a simularilor, pentru analiza ulterioara a deceselor si a
+// livrarilor intarziate. Fisierul incepe cu TRACE_MAGIC, apoi urmeaza
+// inregistrari scrise secvential:
+//   [tip: 1 octet][delta tick: varint][campuri: varint x numarul tipului]
+// Tick-ul se codifica relativ la inregistrarea anterioara si revine la 0 la
+// fiecare TRACE_SIM_BEGIN; toate campurile sunt intregi fara semn (LEB128),
+// cu exceptia profitului din TRACE_SIM_END, codificat zigzag.
+enum TraceEvent : uint8_t {
+    TRACE_SIM_BEGIN = 1,  // scenariu, seed
+    TRACE_SPAWN,          // pachet, x, y, reward, deadline
+    TRACE_ASSIGN,         // agent, pachet
+    TRACE_CHARGE,         // agent, x, y (incarcatorul tinta)
+    TRACE_DEATH,          // agent, tip, x, y
+    TRACE_DELIVER,        // pachet, agent, intarziere
+    TRACE_SIM_END,        // livrate, esuate, profit (zigzag)
+    TRACE_EVENT_COUNT
+};
+
+extern const char TRACE_MAGIC[8];
+
+// Numarul de campuri al fiecarui tip de inregistrare
+inline int traceFieldCount(TraceEvent type) {
+    static const int counts[TRACE_EVENT_COUNT] = {0, 2, 5, 2, 3, 4, 3, 3};
+    return type < TRACE_EVENT_COUNT ? counts[type] : 0;
+}
+
+const char* traceEventName(TraceEvent type);
+
+inline uint64_t zigzagEncode(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+inline int64_t zigzagDecode(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+// Scriitor secvential cu buffer propriu; un scriitor per thread
+class TraceWriter {
+private:
+    static const size_t FLUSH_BYTES = 1 << 16;
+
+    std::string path;
+    FILE* file;
+    bool writeFailed;   // o scriere incompleta (de exemplu disc plin)
+    std::vector<uint8_t> buffer;
+    int currentTick;
+    int lastTick;
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            buffer.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        buffer.push_back((uint8_t)v);
+    }
+
+    void flush();
+
+public:
+    explicit TraceWriter(const std::string& path);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+    // Scrie restul bufferului si inchide fisierul; arunca runtime_error daca
+    // vreo scriere a esuat (urma e incompleta, desi poate parea valida).
+    // Destructorul inchide fara verificare, deci rularile reusite apeleaza close().
+    void close();
+
+    void beginSimulation(uint32_t scenario, uint32_t seed);
+    void setTick(int tick) { currentTick = tick; }
+
+    // Campurile lipsa pentru tipul dat sunt ignorate
+    void record(TraceEvent type, uint64_t a = 0, uint64_t b = 0, uint64_t c = 0,
+                uint64_t d = 0, uint64_t e = 0) {
+        buffer.push_back(type);
+        putVarint((uint64_t)(currentTick - lastTick));
+        lastTick = currentTick;
+        const uint64_t fields[] = {a, b, c, d, e};
+        for (int i = 0; i < traceFieldCount(type); i++) putVarint(fields[i]);
+        if (buffer.size() >= FLUSH_BYTES) flush();
+    }
+};
+
+// Inregistrare decodata
+struct TraceRecord {
+    TraceEvent type;
+    uint32_t scenario;   // din ultimul TRACE_SIM_BEGIN
+    int tick;            // absolut, in simularea curenta
+    uint64_t fields[5];
+};
+
+// Citeste o urma aflata integral in memorie (de exemplu un fisier mmap-at)
+class TraceReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    uint32_t scenario;
+    int tick;
+
+    bool getVarint(uint64_t& v);
+
+public:
+    TraceReader(const uint8_t* _data, size_t _size);
+
+    bool hasValidHeader() const;
+    // false la sfarsitul urmei; arunca runtime_error daca urma e trunchiata
+    bool next(TraceRecord& record);
+};
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstddef>
+#include <vector>
 
 struct Point {
     int x, y;
@@ -21,4 +23,25 @@ struct Point {
     }
 };
 
+// Vedere ne-detinatoare peste elemente contigue (echivalentul minimal al
+// std::span din C++20). Nu copiaza nimic; sursa trebuie sa traiasca mai mult.
+template <typename T>
+class Span {
+private:
+    T* first;
+    size_t count;
+
+public:
+    Span() : first(nullptr), count(0) {}
+    Span(T* data, size_t size) : first(data), count(size) {}
+    template <typename Alloc>
+    Span(std::vector<T, Alloc>& v) : first(v.data()), count(v.size()) {}
+
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) const { return first[i]; }
+};
+
 #endif
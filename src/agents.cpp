@@ -1,38 +1,73 @@
 #include "agents.h"
 #include "map.h"
 #include "hivemind.h" 
+#include "trace.h"
 #include <queue>
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <memory>
+#include <stdexcept>
 
 using namespace std;
 
-static Point findNextStepBFS(const Point& start, const Point& target, const Map& map) {
+// Nod din open list-ul A* / JPS
+struct SearchNode {
+    int f;
+    int g;
+    int idx;
+};
+
+// Buffere comune tuturor cautarilor de pe acelasi thread. In loc sa stergem
+// `visited` la fiecare cautare, il marcam cu un token nou la fiecare rulare.
+struct SearchBuffers {
+    std::vector<int> visited;
+    std::vector<int> parent;
+    std::vector<int> gScore;
+    std::vector<int> q_vec;
+    std::vector<SearchNode> heap;
+    int runToken = 0;
+};
+
+static SearchBuffers& prepareSearch(int area) {
+    static thread_local SearchBuffers buffers;
+
+    if ((int)buffers.visited.size() != area) {
+        buffers.visited.assign(area, 0);
+        buffers.parent.assign(area, -1);
+        buffers.gScore.assign(area, 0);
+        buffers.q_vec.resize(area);
+    }
+
+    buffers.runToken++;
+    if (buffers.runToken == 0) {
+        std::fill(buffers.visited.begin(), buffers.visited.end(), 0);
+        buffers.runToken = 1;
+    }
+    buffers.heap.clear();
+    return buffers;
+}
+
+// Min-heap dupa f; la egalitate preferam g mai mare (mai aproape de tinta)
+static bool heapAfter(const SearchNode& a, const SearchNode& b) {
+    return a.f > b.f || (a.f == b.f && a.g < b.g);
+}
+
+static Point findNextStepBFS(const Point& start, const Point& target, const Map& map,
+                             int& expanded) {
+    expanded = 0;
     if (start == target) return start;
 
     int h = map.getHeight();
     int w = map.getWidth();
     int area = h * w;
 
-    static thread_local std::vector<int> visited;
-    static thread_local std::vector<int> parent;
-    static thread_local std::vector<int> q_vec;
-    static thread_local int runToken = 0;
-    
-    if ((int)visited.size() != area) {
-        visited.assign(area, 0);
-        parent.assign(area, -1);
-        q_vec.resize(area); 
-    }
-
-    runToken++;
-    if (runToken == 0) { 
-        std::fill(visited.begin(), visited.end(), 0);
-        runToken = 1;
-    }
+    SearchBuffers& sb = prepareSearch(area);
+    std::vector<int>& visited = sb.visited;
+    std::vector<int>& parent = sb.parent;
+    std::vector<int>& q_vec = sb.q_vec;
+    int runToken = sb.runToken;
 
     // Helper lambda rapid pentru indexare 1D
     auto toIdx = [&](int x, int y) { return y * w + x; };
@@ -57,6 +92,7 @@ static Point findNextStepBFS(const Point& start, const Point& target, const Map&
     // BFS Loop (Foarte rapid, acces direct la memorie)
     while(head < tail) {
         int currentIdx = q_vec[head++];
+        expanded++;
 
         if (currentIdx == targetIdx) {
             found = true;
@@ -69,18 +105,15 @@ static Point findNextStepBFS(const Point& start, const Point& target, const Map&
             int nx = current.x + dx[i];
             int ny = current.y + dy[i];
 
-            // Verificare limite manuala
-            if (nx >= 0 && nx < w && ny >= 0 && ny < h) {
-                // Accesam gridul. Nota: getCell e rapid, dar daca ai acces direct la vectorul hartii e si mai bine
-                if (map.getCell(nx, ny) != CELL_WALL) {
-                    int nIdx = toIdx(nx, ny);
-
-                    // Verificam token-ul in loc de bool
-                    if (visited[nIdx] != runToken) {
-                        visited[nIdx] = runToken;
-                        parent[nIdx] = currentIdx;
-                        q_vec[tail++] = nIdx;
-                    }
+            // Bitboard-ul are padding pe margini, deci nu mai verificam limitele
+            if (map.isWalkable(nx, ny)) {
+                int nIdx = toIdx(nx, ny);
+
+                // Verificam token-ul in loc de bool
+                if (visited[nIdx] != runToken) {
+                    visited[nIdx] = runToken;
+                    parent[nIdx] = currentIdx;
+                    q_vec[tail++] = nIdx;
                 }
             }
         }
@@ -100,174 +133,444 @@ static Point findNextStepBFS(const Point& start, const Point& target, const Map&
 
     return start; // Nu exista drum, stam pe loc
 }
-// Implementare Agent
-Agent::Agent(int _id, int x, int y, AgentType _type, 
-             float _maxBattery, float _consumption, int _costPerTick)
-    : id(_id), type(_type), position({x, y}), target({x, y}),
-      battery(_maxBattery), maxBattery(_maxBattery), 
-      consumption(_consumption), costPerTick(_costPerTick),
-      state(IDLE), currentPackage(nullptr) {
-	  hasPhysicalPackage = false;
-      }
-
-void Agent::charge() {
-    if (state == CHARGING || state == IDLE) {
-        battery += maxBattery * 0.25f; 
-        if (battery > maxBattery) {
-            battery = maxBattery;
+
+Point BfsPathfinder::findNextStep(const Point& start, const Point& target, const Map& map) {
+    return findNextStepBFS(start, target, map, lastExpanded);
+}
+
+Point AStarPathfinder::findNextStep(const Point& start, const Point& target, const Map& map) {
+    lastExpanded = 0;
+    if (start == target) return start;
+
+    int w = map.getWidth();
+    SearchBuffers& sb = prepareSearch(map.getHeight() * w);
+    std::vector<SearchNode>& heap = sb.heap;
+
+    int startIdx = start.y * w + start.x;
+    int targetIdx = target.y * w + target.x;
+
+    sb.visited[startIdx] = sb.runToken;
+    sb.gScore[startIdx] = 0;
+    sb.parent[startIdx] = -1;
+    heap.push_back({Point::distance(start, target), 0, startIdx});
+
+    const int dx[] = {0, 0, -1, 1};
+    const int dy[] = {-1, 1, 0, 0};
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), heapAfter);
+        SearchNode node = heap.back();
+        heap.pop_back();
+
+        // Intrare veche: nodul a fost deja gasit cu un cost mai mic
+        if (node.g != sb.gScore[node.idx]) continue;
+        lastExpanded++;
+
+        if (node.idx == targetIdx) {
+            int curr = targetIdx;
+            int prev = -1;
+            while (curr != startIdx) {
+                prev = curr;
+                curr = sb.parent[curr];
+            }
+            return Point{prev % w, prev / w};
+        }
+
+        int cx = node.idx % w;
+        int cy = node.idx / w;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+            if (!map.isWalkable(nx, ny)) continue;
+
+            int nIdx = ny * w + nx;
+            int ng = node.g + 1;
+            if (sb.visited[nIdx] != sb.runToken || ng < sb.gScore[nIdx]) {
+                sb.visited[nIdx] = sb.runToken;
+                sb.gScore[nIdx] = ng;
+                sb.parent[nIdx] = node.idx;
+                heap.push_back({ng + Point::distance(Point{nx, ny}, target), ng, nIdx});
+                std::push_heap(heap.begin(), heap.end(), heapAfter);
+            }
+        }
+    }
+
+    return start;
+}
+
+// Salt orizontal pentru JPS pe grid 4-conex. Se opreste la tinta sau la o
+// celula cu vecin fortat (deasupra/dedesubt se deschide un culoar).
+static bool jumpHorizontal(int& x, int y, int dx, const Point& target, const Map& map) {
+    while (true) {
+        if (!map.isWalkable(x, y)) return false;
+        if (x == target.x && y == target.y) return true;
+        if ((map.isWalkable(x, y - 1) && !map.isWalkable(x - dx, y - 1)) ||
+            (map.isWalkable(x, y + 1) && !map.isWalkable(x - dx, y + 1))) {
+            return true;
+        }
+        x += dx;
+    }
+}
+
+// Salt vertical: pe langa vecinii fortati, fiecare celula e punct de salt
+// daca un salt orizontal din ea gaseste ceva.
+static bool jumpVertical(int x, int& y, int dy, const Point& target, const Map& map) {
+    while (true) {
+        if (!map.isWalkable(x, y)) return false;
+        if (x == target.x && y == target.y) return true;
+        if ((map.isWalkable(x - 1, y) && !map.isWalkable(x - 1, y - dy)) ||
+            (map.isWalkable(x + 1, y) && !map.isWalkable(x + 1, y - dy))) {
+            return true;
+        }
+        int hx = x + 1;
+        if (jumpHorizontal(hx, y, 1, target, map)) return true;
+        hx = x - 1;
+        if (jumpHorizontal(hx, y, -1, target, map)) return true;
+        y += dy;
+    }
+}
+
+Point JpsPathfinder::findNextStep(const Point& start, const Point& target, const Map& map) {
+    lastExpanded = 0;
+    if (start == target) return start;
+
+    int w = map.getWidth();
+    SearchBuffers& sb = prepareSearch(map.getHeight() * w);
+    std::vector<SearchNode>& heap = sb.heap;
+
+    int startIdx = start.y * w + start.x;
+    int targetIdx = target.y * w + target.x;
+
+    sb.visited[startIdx] = sb.runToken;
+    sb.gScore[startIdx] = 0;
+    sb.parent[startIdx] = -1;
+    heap.push_back({Point::distance(start, target), 0, startIdx});
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), heapAfter);
+        SearchNode node = heap.back();
+        heap.pop_back();
+
+        if (node.g != sb.gScore[node.idx]) continue;
+        lastExpanded++;
+
+        if (node.idx == targetIdx) {
+            // Segmentele dintre punctele de salt sunt drepte, deci primul pas
+            // e directia spre primul punct de salt de dupa start
+            int curr = targetIdx;
+            int prev = -1;
+            while (curr != startIdx) {
+                prev = curr;
+                curr = sb.parent[curr];
+            }
+            int px = prev % w;
+            int py = prev / w;
+            return Point{start.x + (px > start.x) - (px < start.x),
+                         start.y + (py > start.y) - (py < start.y)};
+        }
+
+        int cx = node.idx % w;
+        int cy = node.idx / w;
+
+        // Directiile de explorat: toate 4 din start, altfel doar cele
+        // care nu pot fi atinse mai ieftin prin parinte
+        int dirs[4][2];
+        int dirCount = 0;
+        int parentIdx = sb.parent[node.idx];
+        if (parentIdx < 0) {
+            const int all[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+            for (int i = 0; i < 4; i++) {
+                dirs[dirCount][0] = all[i][0];
+                dirs[dirCount][1] = all[i][1];
+                dirCount++;
+            }
+        } else {
+            int pdx = (cx > parentIdx % w) - (cx < parentIdx % w);
+            int pdy = (cy > parentIdx / w) - (cy < parentIdx / w);
+            if (pdx != 0) {
+                dirs[0][0] = 0;   dirs[0][1] = -1;
+                dirs[1][0] = 0;   dirs[1][1] = 1;
+                dirs[2][0] = pdx; dirs[2][1] = 0;
+            } else {
+                dirs[0][0] = -1;  dirs[0][1] = 0;
+                dirs[1][0] = 1;   dirs[1][1] = 0;
+                dirs[2][0] = 0;   dirs[2][1] = pdy;
+            }
+            dirCount = 3;
+        }
+
+        for (int i = 0; i < dirCount; i++) {
+            int jx = cx + dirs[i][0];
+            int jy = cy + dirs[i][1];
+            bool found = dirs[i][0] != 0
+                ? jumpHorizontal(jx, jy, dirs[i][0], target, map)
+                : jumpVertical(jx, jy, dirs[i][1], target, map);
+            if (!found) continue;
+
+            int jIdx = jy * w + jx;
+            int ng = node.g + std::abs(jx - cx) + std::abs(jy - cy);
+            if (sb.visited[jIdx] != sb.runToken || ng < sb.gScore[jIdx]) {
+                sb.visited[jIdx] = sb.runToken;
+                sb.gScore[jIdx] = ng;
+                sb.parent[jIdx] = node.idx;
+                heap.push_back({ng + Point::distance(Point{jx, jy}, target), ng, jIdx});
+                std::push_heap(heap.begin(), heap.end(), heapAfter);
+            }
         }
     }
+
+    return start;
 }
 
+unique_ptr<IPathfinder> PathfinderFactory::create(PathfinderType type) {
+    switch (type) {
+        case PATHFINDER_BFS:
+            return unique_ptr<IPathfinder>(new BfsPathfinder());
+        case PATHFINDER_ASTAR:
+            return unique_ptr<IPathfinder>(new AStarPathfinder());
+        case PATHFINDER_JPS:
+            return unique_ptr<IPathfinder>(new JpsPathfinder());
+        default:
+            throw std::invalid_argument("PathfinderFactory: tip de pathfinder necunoscut");
+    }
+}
+
+// Tintele obisnuite (baza, clienti, statii) au camp de distanta precalculat
+// in Map; cautarea completa ramane doar pentru tinte fara camp.
+static Point findNextStep(const Point& start, const Point& target, const Map& map,
+                          IPathfinder* pathfinder) {
+    Point next;
+    if (map.nextStepToward(start, target, next)) return next;
+    if (pathfinder) return pathfinder->findNextStep(start, target, map);
+
+    int expanded;
+    return findNextStepBFS(start, target, map, expanded);
+}
+// Parametrii pe tip: baterie maxima, consum/tick, cost/tick, viteza (celule/tick)
+static const AgentSpec AGENT_SPECS[] = {
+    {100.0f, 10.0f, 15, 3}, // DRONE
+    {300.0f,  2.0f,  1, 1}, // ROBOT
+    {200.0f,  5.0f,  4, 2}  // SCOOTER
+};
+
+const AgentSpec& getAgentSpec(AgentType type) {
+    return AGENT_SPECS[type];
+}
+
+// Implementare Agent (vedere asupra flotei)
 void Agent::assignTask(Package* pkg, Point dest) {
-    currentPackage = pkg;
-    hasPhysicalPackage = false;
-    target = dest;
-    state = MOVING;
+    fleet->packages[slot] = pkg;
+    fleet->carrying[slot] = 0;
+    fleet->targetX[slot] = dest.x;
+    fleet->targetY[slot] = dest.y;
+    fleet->states[slot] = MOVING;
+    if (fleet->trace) fleet->trace->record(TRACE_ASSIGN, getId(), pkg->id);
 }
 
 void Agent::sendToCharge(Point station) {
-    target = station;
-    state = MOVING;
+    if (fleet->trace) fleet->trace->record(TRACE_CHARGE, getId(), station.x, station.y);
+    fleet->targetX[slot] = station.x;
+    fleet->targetY[slot] = station.y;
+    fleet->states[slot] = MOVING;
    
-    if (currentPackage) {
-        currentPackage->assigned = false;
-        currentPackage = nullptr;
+    Package*& pkg = fleet->packages[slot];
+    if (pkg) {
+        pkg->assigned = false;
+        pkg = nullptr;
     }
 }
 
 void Agent::dropPackage() {
-    currentPackage = nullptr;
-    state = IDLE;
+    fleet->packages[slot] = nullptr;
+    fleet->states[slot] = IDLE;
 }
 
-void Agent::updatePosition(Point newPos) {
-    position = newPos;
+// Implementare Fleet
+void Fleet::init(int drones, int robots, int scooters, Point base) {
+    int counts[] = {drones, robots, scooters};
+    int total = drones + robots + scooters;
+
+    ids.resize(total);
+    types.resize(total);
+    posX.assign(total, base.x);
+    posY.assign(total, base.y);
+    targetX.assign(total, base.x);
+    targetY.assign(total, base.y);
+    battery.resize(total);
+    states.assign(total, IDLE);
+    packages.assign(total, nullptr);
+    carrying.assign(total, 0);
+    stationary.assign(total, 0);
+    diedNow.assign(total, 0);
+
+    int slot = 0;
+    for (int t = 0; t < 3; t++) {
+        typeOffset[t] = slot;
+        for (int i = 0; i < counts[t]; i++, slot++) {
+            ids[slot] = slot;
+            types[slot] = static_cast<AgentType>(t);
+            battery[slot] = AGENT_SPECS[t].maxBattery;
+        }
+    }
+    typeOffset[3] = slot;
+
+    handles.clear();
+    handles.reserve(total);
+    for (int i = 0; i < total; i++) {
+        handles.emplace_back(this, i);
+    }
 }
 
-Drone::Drone(int id, int x, int y) 
-    : Agent(id, x, y, DRONE, 100.0f, 10.0f, 15) {}
+FleetTickTotals Fleet::updateRange(const Map& map, int begin, int end, IPathfinder* pf) {
+    // Citirea hartii e un gather, deci o facem separat de buclele pe tablouri
+    for (int i = begin; i < end; i++) {
+        char cell = map.getCell(posX[i], posY[i]);
+        bool onChargingCell = (cell == CELL_BASE || cell == CELL_STATION);
+        stationary[i] = onChargingCell && states[i] != MOVING;
+    }
+
+    FleetTickTotals totals;
+    for (int t = 0; t < 3; t++) {
+        int first = std::max(begin, typeOffset[t]);
+        int last = std::min(end, typeOffset[t + 1]);
+        if (first < last) totals.cost += updateEnergy(static_cast<AgentType>(t), first, last);
+    }
 
-void Drone::move(const Map& map) {
-    (void)map;
+    for (int i = begin; i < end; i++) totals.deaths += diedNow[i];
 
-    battery -= consumption;
-    if (battery <= 0) {
-        battery = 0;
-        state = DEAD;
-        return;
+    moveDrones(map, std::max(begin, typeOffset[DRONE]), std::min(end, typeOffset[DRONE + 1]));
+    for (AgentType type : {ROBOT, SCOOTER}) {
+        moveGround(type, map, std::max(begin, typeOffset[type]), std::min(end, typeOffset[type + 1]), pf);
     }
-    
-    if (state != MOVING) return;
-    
-    int speed = static_cast<int>(getSpeed());
-    
-    for (int i = 0; i < speed && position != target; i++) {
-        if (position.x < target.x) position.x++;
-        else if (position.x > target.x) position.x--;
-        else if (position.y < target.y) position.y++;
-        else if (position.y > target.y) position.y--;
+
+    return totals;
+}
+
+void Fleet::collectDied(std::vector<int>& died) const {
+    died.clear();
+    for (int i = 0; i < size(); i++) {
+        if (diedNow[i]) died.push_back(i);
     }
-    
-    if (position == target) {
-	if (currentPackage != nullptr && !hasPhysicalPackage) {
-            if (position == map.getBasePosition()) {
-                hasPhysicalPackage = true;        
-                target = currentPackage->destCoord; 
-            }
-        }
-        
-        else if (currentPackage != nullptr && hasPhysicalPackage) {
-            state = IDLE;
-        } else {
-            state = IDLE;
-        }
+}
+
+// Costuri, incarcare si consum pentru agentii unui tip din [begin, end).
+// Scrisa fara ramificari, ca sa fie vectorizata: agentii de pe celule de
+// incarcare care nu se misca se incarca, restul consuma; cine ramane fara
+// baterie moare.
+long long Fleet::updateEnergy(AgentType type, int begin, int end) {
+    const AgentSpec& spec = AGENT_SPECS[type];
+    const float chargeStep = spec.maxBattery * 0.25f;
+    int billed = 0;
+
+    AgentState* st = states.data();
+    float* bat = battery.data();
+    const int* still = stationary.data();
+    int* died = diedNow.data();
+
+    for (int i = begin; i < end; i++) {
+        float before = bat[i];
+        int state = st[i];
+        int alive = state != DEAD;
+        int charging = alive & still[i];
+        int draining = alive & (still[i] ^ 1);
+
+        //taxam daca e in miscare sau daca e idle in afara statiei
+        billed += draining;
+
+        float charged = before + chargeStep < spec.maxBattery ? before + chargeStep : spec.maxBattery;
+        float drained = before - spec.consumption;
+        int dies = draining & (drained <= 0.0f);
+
+        // Selectiile pe stare sunt aritmetice: cu operatorul ?: pe int si float
+        // amestecate, gcc renunta la vectorizare
+        int chargeState = before < spec.maxBattery ? CHARGING : IDLE;
+        int next = state + charging * (chargeState - state) + dies * (DEAD - state);
+
+        float nextBattery = charging ? charged : before;
+        nextBattery = draining ? drained : nextBattery;
+        nextBattery = nextBattery > 0.0f ? nextBattery : 0.0f;
+
+        st[i] = static_cast<AgentState>(next);
+        bat[i] = nextBattery;
+        died[i] = dies;
     }
+    return (long long)billed * spec.costPerTick;
 }
 
-Robot::Robot(int id, int x, int y) 
-    : Agent(id, x, y, ROBOT, 300.0f, 2.0f, 1) {}
+// Dronele zboara direct: intai pe X, apoi pe Y, cu `speed` celule pe tick
+void Fleet::moveDrones(const Map& map, int first, int last) {
+    const int speed = AGENT_SPECS[DRONE].speed;
 
-void Robot::move(const Map& map) {
-    
-    battery -= consumption;
-    if (battery <= 0) {
-        battery = 0;
-        state = DEAD;
-        return;
-    }
+    for (int i = first; i < last; i++) {
+        int moving = states[i] == MOVING;
 
-    if (state != MOVING) return;
-    
-    if (position != target) {
-        Point nextStep = findNextStepBFS(position, target, map);
-        position = nextStep;
+        int dx = targetX[i] - posX[i];
+        int stepX = std::min(std::abs(dx), speed);
+        int rest = speed - stepX;
+        int dy = targetY[i] - posY[i];
+        int stepY = std::min(std::abs(dy), rest);
+
+        int nx = posX[i] + (dx > 0 ? stepX : -stepX);
+        int ny = posY[i] + (dy > 0 ? stepY : -stepY);
+        posX[i] = moving ? nx : posX[i];
+        posY[i] = moving ? ny : posY[i];
     }
-    
-    
-    if (position == target) {
-	if (currentPackage != nullptr && !hasPhysicalPackage) {
-            if (position == map.getBasePosition()) {
-                hasPhysicalPackage = true;        
-                target = currentPackage->destCoord; 
-            }
-        }
-        
-        else if (currentPackage != nullptr && hasPhysicalPackage) {
-            state = IDLE;
-        } else {
-            state = IDLE;
-        }
+
+    for (int i = first; i < last; i++) {
+        if (states[i] == MOVING) handleArrival(i, map);
     }
 }
 
-Scooter::Scooter(int id, int x, int y) 
-    : Agent(id, x, y, SCOOTER, 200.0f, 5.0f, 4) {}
+void Fleet::moveGround(AgentType type, const Map& map, int begin, int end, IPathfinder* pf) {
+    const int speed = AGENT_SPECS[type].speed;
 
-void Scooter::move(const Map& map) {
-    
-    battery -= consumption;
-    if (battery <= 0) {
-        battery = 0;
-        state = DEAD;
-        return;
-    }
-    
-    if (state != MOVING) return;
-
-    int speed = static_cast<int>(getSpeed());
-    
-    for (int i = 0; i < speed && position != target; i++) {
-        Point nextStep = findNextStepBFS(position, target, map);
-        position = nextStep;
-    }
-    
+    for (int i = begin; i < end; i++) {
+        if (states[i] != MOVING) continue;
 
-    if (position == target) {
-	if (currentPackage != nullptr && !hasPhysicalPackage) {
-            if (position == map.getBasePosition()) {
-                hasPhysicalPackage = true;        
-                target = currentPackage->destCoord; 
-            }
+        Point position = {posX[i], posY[i]};
+        Point target = {targetX[i], targetY[i]};
+        for (int s = 0; s < speed && position != target; s++) {
+            position = findNextStep(position, target, map, pf);
         }
-        
-        else if (currentPackage != nullptr && hasPhysicalPackage) {
-            state = IDLE;
-        } else {
-            state = IDLE;
+        posX[i] = position.x;
+        posY[i] = position.y;
+
+        handleArrival(i, map);
+    }
+}
+
+void Fleet::handleArrival(int i, const Map& map) {
+    if (posX[i] != targetX[i] || posY[i] != targetY[i]) return;
+
+    Package* pkg = packages[i];
+    if (pkg != nullptr && !carrying[i]) {
+        // A ajuns la baza: ridica pachetul si pleaca spre client
+        if (Point{posX[i], posY[i]} == map.getBasePosition()) {
+            carrying[i] = 1;
+            targetX[i] = pkg->destCoord.x;
+            targetY[i] = pkg->destCoord.y;
         }
+    } else {
+        states[i] = IDLE;
     }
 }
 
-unique_ptr<Agent> AgentFactory::create(AgentType type, int id, int x, int y) {
-    switch (type) {
-        case DRONE:
-            return unique_ptr<Agent>(new Drone(id, x, y));
-        case ROBOT:
-            return unique_ptr<Agent>(new Robot(id, x, y));
-        case SCOOTER:
-            return unique_ptr<Agent>(new Scooter(id, x, y));
-        default:
-            throw std::invalid_argument("AgentFactory: nu s-a gasit tipul de agent");
+void Fleet::releasePackage(int slot) {
+    if (packages[slot]) {
+        packages[slot]->assigned = false;
+        packages[slot] = nullptr;
     }
 }
+
+int Fleet::countAlive() const {
+    int alive = 0;
+    for (AgentState state : states) alive += state != DEAD;
+    return alive;
+}
+
+int Fleet::countAlive(AgentType type) const {
+    int alive = 0;
+    for (int i = typeOffset[type]; i < typeOffset[type + 1]; i++) alive += states[i] != DEAD;
+    return alive;
+}
@@ -0,0 +1,85 @@
+#include "alloccount.h"
+
+#ifdef COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// Inlocuirea operatorilor globali: numara fiecare alocare din thread-ul curent
+static thread_local size_t threadAllocations = 0;
+
+bool allocationCountingEnabled() {
+    return true;
+}
+
+size_t getThreadAllocationCount() {
+    return threadAllocations;
+}
+
+// Ca operatorul standard: la esec apeleaza new_handler-ul instalat si
+// reincearca; fara handler arunca bad_alloc
+void* operator new(size_t size) {
+    threadAllocations++;
+    if (size == 0) size = 1;
+    while (true) {
+        void* p = malloc(size);
+        if (p) return p;
+        new_handler handler = get_new_handler();
+        if (!handler) throw bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return ::operator new(size, nothrow);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, const nothrow_t&) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, const nothrow_t&) noexcept {
+    free(p);
+}
+
+#else
+
+bool allocationCountingEnabled() {
+    return false;
+}
+
+size_t getThreadAllocationCount() {
+    return 0;
+}
+
+#endif
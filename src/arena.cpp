@@ -0,0 +1,50 @@
+#include "arena.h"
+#include <algorithm>
+
+using namespace std;
+
+Arena::~Arena() {
+    release();
+    for (auto& block : blocks) ::operator delete(block.data);
+}
+
+void* Arena::allocateSlow(size_t size, size_t align) {
+    // Incercam blocurile deja rezervate (pastrate dupa release/rewind)
+    while (current + 1 < blocks.size()) {
+        current++;
+        offset = 0;
+        size_t aligned = (offset + align - 1) & ~(align - 1);
+        if (aligned + size <= blocks[current].size) {
+            offset = aligned + size;
+            return blocks[current].data + aligned;
+        }
+    }
+
+    // Cererile mari primesc un bloc propriu, restul blocuri de dimensiune fixa.
+    // Memoria din operator new e aliniata la max_align_t, deci offset 0 e aliniat.
+    size_t newSize = max(blockSize, size);
+    Block block = {static_cast<char*>(::operator new(newSize)), newSize};
+    blocks.push_back(block);
+    current = blocks.size() - 1;
+    offset = size;
+    return blocks[current].data;
+}
+
+void Arena::rewind(const Marker& marker) {
+    while (finalizers.size() > marker.finalizers) {
+        finalizers.back().destroy(finalizers.back().object);
+        finalizers.pop_back();
+    }
+    current = marker.block;
+    offset = marker.offset;
+}
+
+void Arena::release() {
+    rewind({0, 0, 0});
+}
+
+size_t Arena::bytesReserved() const {
+    size_t total = 0;
+    for (const auto& block : blocks) total += block.size;
+    return total;
+}
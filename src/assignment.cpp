@@ -0,0 +1,105 @@
+#include "assignment.h"
+#include <queue>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+void AssignmentSolver::addArc(int from, int to, double cost, int edge) {
+    graph[from].push_back({to, (int)graph[to].size(), 1, cost, edge});
+    graph[to].push_back({from, (int)graph[from].size() - 1, 0, -cost, -1});
+}
+
+vector<int> AssignmentSolver::solve(int numAgents, int numPackages,
+                                    const vector<AssignmentEdge>& edges) {
+    // Noduri: sursa, agentii, pachetele, destinatia
+    int source = 0;
+    int firstPackage = 1 + numAgents;
+    int sink = firstPackage + numPackages;
+    int nodes = sink + 1;
+
+    for (auto& arcs : graph) arcs.clear();
+    graph.resize(nodes);
+
+    for (int a = 0; a < numAgents; a++) addArc(source, 1 + a, 0.0, -1);
+    for (int p = 0; p < numPackages; p++) addArc(firstPackage + p, sink, 0.0, -1);
+    for (size_t e = 0; e < edges.size(); e++) {
+        addArc(1 + edges[e].agent, firstPackage + edges[e].package, -edges[e].weight, (int)e);
+    }
+
+    // Potentiale initiale: graful e aciclic (sursa -> agent -> pachet -> destinatie)
+    const double INF = numeric_limits<double>::infinity();
+    potential.assign(nodes, 0.0);
+    for (int p = 0; p < numPackages; p++) potential[firstPackage + p] = INF;
+    for (const auto& e : edges) {
+        double& pot = potential[firstPackage + e.package];
+        pot = min(pot, -e.weight);
+    }
+    double sinkPot = 0.0;
+    for (int p = 0; p < numPackages; p++) {
+        if (potential[firstPackage + p] == INF) potential[firstPackage + p] = 0.0;
+        sinkPot = min(sinkPot, potential[firstPackage + p]);
+    }
+    potential[sink] = sinkPot;
+
+    dist.resize(nodes);
+    prevNode.resize(nodes);
+    prevArc.resize(nodes);
+
+    typedef pair<double, int> QueueItem;
+    priority_queue<QueueItem, vector<QueueItem>, greater<QueueItem>> pq;
+
+    while (true) {
+        fill(dist.begin(), dist.end(), INF);
+        dist[source] = 0.0;
+        pq.push({0.0, source});
+
+        while (!pq.empty()) {
+            QueueItem item = pq.top();
+            pq.pop();
+            int u = item.second;
+            if (item.first > dist[u]) continue;
+
+            for (size_t i = 0; i < graph[u].size(); i++) {
+                const Arc& arc = graph[u][i];
+                if (arc.cap == 0) continue;
+
+                // Costul redus e >= 0 teoretic; taiem erorile de rotunjire
+                double reduced = max(0.0, arc.cost + potential[u] - potential[arc.to]);
+                double nd = dist[u] + reduced;
+                if (nd < dist[arc.to]) {
+                    dist[arc.to] = nd;
+                    prevNode[arc.to] = u;
+                    prevArc[arc.to] = (int)i;
+                    pq.push({nd, arc.to});
+                }
+            }
+        }
+
+        if (dist[sink] == INF) break;
+
+        // Costul real al drumului; daca nu e negativ, augmentarea nu aduce castig
+        double pathCost = dist[sink] + potential[sink] - potential[source];
+        if (pathCost >= 0.0) break;
+
+        for (int v = 0; v < nodes; v++) {
+            if (dist[v] < INF) potential[v] += dist[v];
+        }
+
+        for (int v = sink; v != source; v = prevNode[v]) {
+            Arc& arc = graph[prevNode[v]][prevArc[v]];
+            arc.cap -= 1;
+            graph[v][arc.rev].cap += 1;
+        }
+    }
+
+    // Muchiile saturate agent -> pachet formeaza cuplajul
+    vector<int> chosen;
+    for (int a = 0; a < numAgents; a++) {
+        for (const Arc& arc : graph[1 + a]) {
+            if (arc.edge >= 0 && arc.cap == 0) chosen.push_back(arc.edge);
+        }
+    }
+    return chosen;
+}
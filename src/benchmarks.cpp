@@ -0,0 +1,379 @@
+#include "benchmarks.h"
+#include "map.h"
+#include "agents.h"
+#include "config.h"
+#include "simulation.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+
+using namespace std;
+
+namespace {
+
+struct PathQuery {
+    Point start;
+    Point target;
+};
+
+// Harta fara puncte de interes, doar ziduri aleatoare cu densitatea data
+void buildBenchMap(Map& map, int size, double wallDensity, mt19937& rng) {
+    map.init(size, size);
+    uniform_int_distribution<int> coord(0, size - 1);
+    int walls = static_cast<int>(size * size * wallDensity);
+    for (int i = 0; i < walls; i++) {
+        map.setCell(coord(rng), coord(rng), CELL_WALL);
+    }
+}
+
+// Perechi start/tinta conectate; `maxDist` > 0 limiteaza distanta Manhattan
+vector<PathQuery> buildQueries(const Map& map, int count, int maxDist, mt19937& rng) {
+    vector<PathQuery> queries;
+    vector<uint64_t> reached;
+    uniform_int_distribution<int> coord(0, map.getWidth() - 1);
+
+    while ((int)queries.size() < count) {
+        Point start = {coord(rng), coord(rng)};
+        if (!map.isWalkable(start.x, start.y)) continue;
+        map.floodFill(start, reached);
+
+        for (int tries = 0; tries < 100; tries++) {
+            Point target = {coord(rng), coord(rng)};
+            if (maxDist > 0) {
+                uniform_int_distribution<int> offset(-maxDist, maxDist);
+                target = {start.x + offset(rng), start.y + offset(rng)};
+                if (!map.isValidCoord(target.x, target.y)) continue;
+            }
+            if (target != start && map.isReached(reached, target)) {
+                queries.push_back({start, target});
+                break;
+            }
+        }
+    }
+    return queries;
+}
+
+void benchmarkQueries(const string& label, const Map& map, const vector<PathQuery>& queries) {
+    const PathfinderType types[] = {PATHFINDER_BFS, PATHFINDER_ASTAR, PATHFINDER_JPS};
+    const char* names[] = {"BFS", "A*", "JPS"};
+
+    for (int t = 0; t < 3; t++) {
+        unique_ptr<IPathfinder> pathfinder = PathfinderFactory::create(types[t]);
+        long long expanded = 0;
+        int checksum = 0;
+
+        auto startTime = chrono::steady_clock::now();
+        for (const auto& q : queries) {
+            Point next = pathfinder->findNextStep(q.start, q.target, map);
+            expanded += pathfinder->getLastExpanded();
+            checksum += next.x + next.y;
+        }
+        auto endTime = chrono::steady_clock::now();
+
+        double ns = chrono::duration<double, nano>(endTime - startTime).count() / queries.size();
+        cout << left << setw(28) << label << setw(6) << names[t]
+             << right << setw(12) << fixed << setprecision(1)
+             << (double)expanded / queries.size() << " noduri"
+             << setw(12) << setprecision(0) << ns << " ns/cautare"
+             << "   (checksum " << checksum << ")" << endl;
+    }
+}
+
+// Timpul maxim de rulare (fara initializare) al unei trepte din scara de scalare
+const double SCALING_SECONDS = 2.0;
+
+// Readuce varful de RSS la valoarea curenta (Linux >= 4.0), ca fiecare
+// treapta sa-si masoare propriul varf; false daca nu e suportat
+bool resetPeakRss() {
+    ofstream clearRefs("/proc/self/clear_refs");
+    if (!clearRefs.is_open()) return false;
+    clearRefs << "5";
+    clearRefs.flush();
+    return (bool)clearRefs;
+}
+
+// Varful de RSS in MiB: VmHWM, sau ru_maxrss (varful procesului) ca rezerva
+double peakRssMiB() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return atof(line.c_str() + 6) / 1024.0;
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+void runScalingStep(const string& label, const ScenarioConfig& config, unsigned int tickThreads) {
+    resetPeakRss();
+
+    auto initStart = chrono::steady_clock::now();
+    Simulation sim(config);
+    sim.setTickThreads(tickThreads);
+    sim.reset(Simulation::scenarioSeed(1, 0));
+    sim.initialize();
+    double initMs = chrono::duration<double, milli>(chrono::steady_clock::now() - initStart).count();
+
+    // Tick cu tick pana la capat, la moartea flotei sau la epuizarea timpului
+    long long ticks = 0;
+    long long agentTicks = 0;
+    double seconds = 0.0;
+    bool finished = false;
+    auto start = chrono::steady_clock::now();
+    while (seconds < SCALING_SECONDS) {
+        int agents = sim.getAgentsAlive();
+        if (!sim.step()) {
+            if (sim.getTicksRun() > ticks) {
+                ticks++;
+                agentTicks += agents;
+            }
+            finished = true;
+            break;
+        }
+        ticks++;
+        agentTicks += agents;
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << left << setw(22) << label << right << fixed
+         << setw(8) << ticks
+         << setw(11) << setprecision(1) << initMs
+         << setw(12) << setprecision(0) << (seconds > 0 ? ticks / seconds : 0.0)
+         << setw(14) << setprecision(1) << (agentTicks > 0 ? seconds * 1e9 / agentTicks : 0.0)
+         << setw(10) << sim.getPackagesDelivered()
+         << setw(11) << peakRssMiB() << (finished ? "" : "  (limita de timp)") << endl;
+}
+
+} // namespace
+
+void runScalingBenchmark(unsigned int tickThreads) {
+    const int mapSizes[] = {20, 50, 100, 200, 500, 1000, 2000};
+    const int fleetSizes[] = {6, 60, 600, 2000, 10000};
+    const int packageCounts[] = {50, 500, 5000, 50000, 1000000};
+
+    ScenarioConfig base = ScenarioConfig::loadFromFile("../simulation_setup.txt");
+    int spawns = max(1, base.maxTicks / base.spawnFrequency);
+
+    cout << "--- BENCHMARK SCALARE ---" << endl;
+    cout << "Pornind de la " << base.label() << ", " << base.totalPackages << " pachete; "
+         << "o singura dimensiune variaza pe fiecare scara." << endl;
+    cout << "Fiecare treapta: un scenariu fix, cel mult " << base.maxTicks << " ticks sau "
+         << SCALING_SECONDS << " s de rulare." << endl;
+    if (tickThreads > 1) {
+        cout << "Agentii se actualizeaza pe " << tickThreads << " thread-uri de la "
+             << Simulation::PARALLEL_TICK_MIN_AGENTS << " agenti in sus." << endl;
+    }
+    if (!resetPeakRss()) cout << "(varful RSS nu poate fi resetat: valorile sunt cumulative)" << endl;
+
+    auto header = [](const char* title) {
+        cout << "----------------------------------------" << endl;
+        cout << left << setw(22) << title << right << setw(8) << "TICKS" << setw(11) << "INIT(ms)"
+             << setw(12) << "TICKS/S" << setw(14) << "NS/AGENT-TICK" << setw(10) << "LIVRATE"
+             << setw(11) << "RSS(MiB)" << endl;
+    };
+
+    // Harta: clientii si statiile raman ca in configuratia de baza, deci
+    // creste doar numarul de celule (campuri de distanta, cautari)
+    header("HARTA");
+    for (int size : mapSizes) {
+        ScenarioConfig config = base;
+        config.mapWidth = size;
+        config.mapHeight = size;
+        runScalingStep(to_string(size) + "x" + to_string(size), config, tickThreads);
+    }
+
+    // Flota: proportia 3:2:1 din simulation_setup.txt, restul neschimbat
+    header("FLOTA");
+    for (int fleetSize : fleetSizes) {
+        ScenarioConfig config = base;
+        config.dronesCount = fleetSize / 2;
+        config.robotsCount = fleetSize / 3;
+        config.scootersCount = fleetSize - config.dronesCount - config.robotsCount;
+        runScalingStep(to_string(fleetSize) + " agenti", config, tickThreads);
+    }
+
+    // Pachete: acelasi numar de generari, mai multe pachete la fiecare
+    header("PACHETE");
+    for (int count : packageCounts) {
+        ScenarioConfig config = base;
+        config.totalPackages = count;
+        config.packagesPerSpawn = (count + spawns - 1) / spawns;
+        runScalingStep(to_string(count) + " pachete", config, tickThreads);
+    }
+}
+
+void runPathfindingBenchmark() {
+    const int QUERIES = 2000;
+    const int sizes[] = {64, 256};
+    const double densities[] = {0.0, 0.3};
+
+    cout << "--- BENCHMARK PATHFINDING ---" << endl;
+    cout << QUERIES << " cautari per scenariu, seed fix." << endl;
+
+    for (int size : sizes) {
+        for (double density : densities) {
+            mt19937 rng(42);
+            Map map;
+            buildBenchMap(map, size, density, rng);
+
+            string mapLabel = to_string(size) + "x" + to_string(size) +
+                              (density == 0.0 ? " deschisa" : " aglomerata");
+
+            vector<PathQuery> nearQueries = buildQueries(map, QUERIES, 4, rng);
+            vector<PathQuery> farQueries = buildQueries(map, QUERIES, 0, rng);
+
+            benchmarkQueries(mapLabel + ", aproape", map, nearQueries);
+            benchmarkQueries(mapLabel + ", departe", map, farQueries);
+            cout << "----------------------------------------" << endl;
+        }
+    }
+}
+
+void runAssignmentBenchmark(unsigned long long seedBase) {
+    const int fleetSizes[] = {10, 100, 1000};
+    const int runsPerSize[] = {200, 60, 12};   // flotele mari costa mult per simulare
+    const AssignmentMode modes[] = {ASSIGN_GREEDY, ASSIGN_OPTIMAL};
+    const char* modeNames[] = {"greedy", "optim"};
+
+    ScenarioConfig config = ScenarioConfig::loadFromFile("../simulation_setup.txt");
+    config.maxTicks = 300;
+
+    cout << "--- BENCHMARK ATRIBUIRE PACHETE ---" << endl;
+    cout << "Harta " << config.mapWidth << "x" << config.mapHeight << ", "
+         << config.maxTicks << " ticks, corpus seed-base " << seedBase
+         << ": ambele moduri joaca aceleasi scenarii." << endl;
+
+    for (int f = 0; f < 3; f++) {
+        int fleetSize = fleetSizes[f];
+        int runs = runsPerSize[f];
+        // Aceeasi proportie ca in simulation_setup.txt (3:2:1), backlog proportional cu flota
+        config.dronesCount = fleetSize / 2;
+        config.robotsCount = fleetSize / 3;
+        config.scootersCount = fleetSize - config.dronesCount - config.robotsCount;
+        config.packagesPerSpawn = max(1, fleetSize / 6);
+        config.totalPackages = config.packagesPerSpawn * (config.maxTicks / config.spawnFrequency);
+
+        vector<long long> profits[2];
+        for (int m = 0; m < 2; m++) {
+            long long delivered = 0;
+            long long ticks = 0;
+            double seconds = 0.0;
+
+            Simulation sim(config);
+            sim.setAssignmentMode(modes[m]);
+            for (int run = 0; run < runs; run++) {
+                sim.reset(Simulation::scenarioSeed(seedBase, run));
+                sim.initialize(run);
+
+                auto startTime = chrono::steady_clock::now();
+                sim.run();
+                seconds += chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+                profits[m].push_back(sim.getTotalProfit());
+                delivered += sim.getPackagesDelivered();
+                ticks += sim.getTicksRun();
+            }
+
+            long long profit = 0;
+            for (long long p : profits[m]) profit += p;
+            cout << setw(5) << fleetSize << " agenti  " << left << setw(7) << modeNames[m] << right
+                 << "  profit mediu: " << setw(10) << profit / runs
+                 << "  livrate: " << setw(6) << delivered / runs
+                 << "  " << setw(10) << fixed << setprecision(1)
+                 << (ticks > 0 ? seconds * 1e6 / ticks : 0.0) << " us/tick" << endl;
+        }
+
+        // Diferenta pe perechi (acelasi scenariu) si eroarea ei standard:
+        // castigul unui mod conteaza doar daca e clar peste zgomot
+        double mean = 0.0;
+        for (int run = 0; run < runs; run++) mean += profits[1][run] - profits[0][run];
+        mean /= runs;
+        double variance = 0.0;
+        for (int run = 0; run < runs; run++) {
+            double d = profits[1][run] - profits[0][run] - mean;
+            variance += d * d;
+        }
+        double stderrMean = runs > 1 ? sqrt(variance / (runs - 1) / runs) : 0.0;
+        cout << setw(5) << fleetSize << " agenti  optim - greedy: " << showpos << setprecision(1)
+             << mean << noshowpos << " +/- " << stderrMean << " (eroare standard, "
+             << runs << " scenarii)" << endl;
+    }
+}
+
+void runMapGenerationBenchmark() {
+    const int sizes[] = {20, 50, 100, 200};
+    const int MAPS = 20;
+
+    ScenarioConfig config = ScenarioConfig::loadFromFile("../simulation_setup.txt");
+
+    cout << "--- BENCHMARK GENERARE HARTI ---" << endl;
+    cout << MAPS << " harti per dimensiune, clienti si statii proportionale cu latura, seed fix." << endl;
+    cout << "Timpul per harta exclude campurile de distanta (afisate separat)." << endl;
+    cout << "Mediile sunt pe hartile generate cu succes; tinta de ziduri e fractiunea trasa," << endl;
+    cout << "inainte de pozitiile repetate si de zidurile sterse la reparare." << endl;
+
+    for (int size : sizes) {
+        config.mapWidth = size;
+        config.mapHeight = size;
+        config.clientsCount = size / 2;
+        config.maxStations = max(2, size / 20);
+
+        ProceduralMapGenerator procedural;
+        ConnectedMapGenerator connected;
+        RandomMapGenerator* generators[] = {&procedural, &connected};
+        const char* names[] = {"respingere", "conex"};
+
+        for (int g = 0; g < 2; g++) {
+            generators[g]->seed(42);
+            generators[g]->setBuildDistanceFields(false);
+            long long attempts = 0;
+            long long walls = 0;
+            double fieldsMs = 0.0;
+            int failed = 0;
+            int invalid = 0;
+            Map map;
+
+            double ms = 0.0;
+            for (int i = 0; i < MAPS; i++) {
+                auto startTime = chrono::steady_clock::now();
+                try {
+                    generators[g]->generate(map, config);
+                } catch (const exception&) {
+                    failed++;
+                    continue;
+                }
+                ms += chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+                attempts += g == 0 ? procedural.getLastAttempts() : 1;
+
+                // Campurile de distanta sunt aceleasi pentru ambele generatoare
+                auto fieldsStart = chrono::steady_clock::now();
+                map.buildDistanceFields();
+                fieldsMs += chrono::duration<double, milli>(chrono::steady_clock::now() - fieldsStart).count();
+
+                vector<Point> pois = map.getClients();
+                pois.insert(pois.end(), map.getStations().begin(), map.getStations().end());
+                if (!map.allReachableFrom(map.getBasePosition(), pois)) invalid++;
+                for (int y = 0; y < size; y++) {
+                    for (int x = 0; x < size; x++) walls += map.getCell(x, y) == CELL_WALL;
+                }
+            }
+            // Mediile sunt doar pe hartile generate; esecurile apar separat
+            int generated = max(1, MAPS - failed);
+
+            cout << setw(4) << size << "x" << left << setw(5) << size << setw(12) << names[g] << right
+                 << setw(10) << fixed << setprecision(3) << ms / generated << " ms/harta"
+                 << setw(10) << fieldsMs / generated << " ms campuri"
+                 << setw(9) << setprecision(1) << (double)attempts / generated << " incercari"
+                 << setw(8) << setprecision(1) << 100.0 * walls / ((double)generated * size * size) << "% ziduri"
+                 << " (tinta " << 100.0 * RandomMapGenerator::WALL_DENSITY << "%)"
+                 << "  esuate: " << failed << "  invalide: " << invalid << endl;
+        }
+    }
+}
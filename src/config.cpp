@@ -5,24 +5,13 @@
 #include <cstdlib>
 #include <stdexcept>
 
-Config* Config::instance = nullptr;
-
-Config::Config() : 
-    mapHeight(0), mapWidth(0), maxTicks(0), maxStations(0), 
-    clientsCount(0), dronesCount(0), robotsCount(0), scootersCount(0), 
-    totalPackages(0), spawnFrequency(0) {}
-
-Config* Config::getInstance() {
-    if (instance == nullptr) instance = new Config();
-    return instance;
-}
-
-void Config::loadFromFile(const std::string& filename) {
+ScenarioConfig ScenarioConfig::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-	std::runtime_error("Eroare deschidere fisier: " + filename);
+        throw std::runtime_error("Eroare deschidere fisier: " + filename);
     }
 
+    ScenarioConfig config;
     std::string line, key;
     while (std::getline(file, line)) {
         if (line.empty() || line.find("//") == 0) continue;
@@ -30,15 +19,27 @@ void Config::loadFromFile(const std::string& filename) {
         ss >> key;
         if (key.back() == ':') key.pop_back();
 
-        if (key == "MAP_SIZE") ss >> mapHeight >> mapWidth;
-        else if (key == "MAX_TICKS") ss >> maxTicks;
-        else if (key == "MAX_STATIONS") ss >> maxStations;
-        else if (key == "CLIENTS_COUNT") ss >> clientsCount;
-        else if (key == "DRONES") ss >> dronesCount;
-        else if (key == "ROBOTS") ss >> robotsCount;
-        else if (key == "SCOOTERS") ss >> scootersCount;
-        else if (key == "TOTAL_PACKAGES") ss >> totalPackages;
-        else if (key == "SPAWN_FREQUENCY") ss >> spawnFrequency;
+        if (key == "MAP_SIZE") ss >> config.mapHeight >> config.mapWidth;
+        else if (key == "MAX_TICKS") ss >> config.maxTicks;
+        else if (key == "MAX_STATIONS") ss >> config.maxStations;
+        else if (key == "CLIENTS_COUNT") ss >> config.clientsCount;
+        else if (key == "DRONES") ss >> config.dronesCount;
+        else if (key == "ROBOTS") ss >> config.robotsCount;
+        else if (key == "SCOOTERS") ss >> config.scootersCount;
+        else if (key == "TOTAL_PACKAGES") ss >> config.totalPackages;
+        else if (key == "SPAWN_FREQUENCY") ss >> config.spawnFrequency;
+        else if (key == "PACKAGES_PER_SPAWN") ss >> config.packagesPerSpawn;
     }
     file.close();
+
+    if (config.mapHeight <= 0 || config.mapWidth <= 0 || config.spawnFrequency <= 0) {
+        throw std::runtime_error("Eroare: configuratie incompleta in " + filename);
+    }
+    return config;
+}
+
+std::string ScenarioConfig::label() const {
+    return std::to_string(mapWidth) + "x" + std::to_string(mapHeight) + " " +
+           std::to_string(dronesCount) + "/" + std::to_string(robotsCount) + "/" +
+           std::to_string(scootersCount);
 }
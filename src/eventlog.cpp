@@ -0,0 +1,152 @@
+#include "eventlog.h"
+#include "agents.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+AsyncLogger::AsyncLogger(const string& path)
+    : ring(CAPACITY), head(0), tail(0), stopping(false), out(path) {
+    batch.reserve(BATCH_BYTES * 2);
+    if (out.is_open()) {
+        writer = thread(&AsyncLogger::writerLoop, this);
+    }
+}
+
+AsyncLogger::~AsyncLogger() {
+    if (writer.joinable()) {
+        stopping.store(true, memory_order_release);
+        writer.join();
+    }
+}
+
+void AsyncLogger::writerLoop() {
+    while (true) {
+        // `stopping` se citeste inainte de golire: dupa ce e vazut setat,
+        // producatorul nu mai adauga nimic, deci o ultima golire e completa
+        bool last = stopping.load(memory_order_acquire);
+        if (drain() == 0) {
+            if (last) break;
+            this_thread::sleep_for(chrono::microseconds(200));
+        }
+    }
+    if (!batch.empty()) out.write(batch.data(), batch.size());
+    out.flush();
+}
+
+// Formateaza tot ce e disponibil; scrie cand blocul trece de BATCH_BYTES
+size_t AsyncLogger::drain() {
+    size_t h = head.load(memory_order_relaxed);
+    size_t t = tail.load(memory_order_acquire);
+    for (size_t i = h; i < t; i++) {
+        format(ring[i & (CAPACITY - 1)]);
+        if (batch.size() >= BATCH_BYTES) {
+            out.write(batch.data(), batch.size());
+            batch.clear();
+        }
+    }
+    head.store(t, memory_order_release);
+    return t - h;
+}
+
+static void appendInt(string& s, long long value) {
+    char buffer[24];
+    int n = snprintf(buffer, sizeof(buffer), "%lld", value);
+    s.append(buffer, n);
+}
+
+static const char* agentTypeName(int type) {
+    switch (type) {
+        case DRONE: return "DRONE";
+        case ROBOT: return "ROBOT";
+        case SCOOTER: return "SCOOTER";
+        default: return "NECUNOSCUT";
+    }
+}
+
+static const char* courierName(int type) {
+    return type == DRONE ? "DRONA" : (type == ROBOT ? "ROBOT" : "SCUTER");
+}
+
+void AsyncLogger::format(const LogRecord& r) {
+    batch += "[TICK ";
+    appendInt(batch, r.tick);
+    batch += "] ";
+
+    switch (r.type) {
+        case LOG_INIT_STARTED:
+            batch += "=== INITIALIZARE SIMULARE ===";
+            break;
+        case LOG_INIT_READY:
+            batch += "Simularea este gata să înceapă.";
+            break;
+        case LOG_AGENTS_CREATED:
+            batch += "Creati ";
+            appendInt(batch, r.args[0]);
+            batch += " agenti initiali.";
+            break;
+        case LOG_PACKAGE_SPAWNED:
+            batch += "Generat pachet ";
+            appendInt(batch, r.args[0]);
+            batch += " cu reward ";
+            appendInt(batch, r.args[1]);
+            batch += " si deadline la tick ";
+            appendInt(batch, r.args[2]);
+            break;
+        case LOG_AGENT_DIED:
+            batch += "!!! DECES AGENT !!! ID: ";
+            appendInt(batch, r.args[0]);
+            batch += " [";
+            batch += agentTypeName(r.args[1]);
+            batch += "] a murit la coordonatele (";
+            appendInt(batch, r.args[2]);
+            batch += ", ";
+            appendInt(batch, r.args[3]);
+            batch += "). Baterie epuizata.";
+            break;
+        case LOG_DELIVERED:
+        case LOG_DELIVERED_LATE:
+            batch += "Pachet ";
+            appendInt(batch, r.args[0]);
+            batch += " RECEPTIONAT de client. Livrat de Agent ";
+            appendInt(batch, r.args[1]);
+            batch += " [";
+            batch += courierName(r.args[2]);
+            batch += "]";
+            if (r.type == LOG_DELIVERED_LATE) {
+                batch += " cu intarziere (";
+                appendInt(batch, r.args[3]);
+                batch += " ticks). Penalizare: 50 credite";
+            } else {
+                batch += " la timp.";
+            }
+            break;
+        case LOG_SIM_STARTED:
+            batch += "=== SIMULARE INCEPUTA ===";
+            break;
+        case LOG_SIM_MAX_TICKS:
+            batch += "Simulare pornita. Max ticks: ";
+            appendInt(batch, r.args[0]);
+            break;
+        case LOG_HEARTBEAT:
+            batch += "--- HEARTBEAT spawnPackages();: Tick ";
+            appendInt(batch, r.args[0]);
+            batch += " ---";
+            break;
+        case LOG_ALL_AGENTS_DEAD:
+            batch += "Toti agentii au murit! Simularea se opreste prematur.";
+            break;
+        case LOG_SIM_FINISHED:
+            batch += "=== SIMULARE TERMINATA ===";
+            break;
+        case LOG_SIM_DURATION:
+            batch += "Durata: ";
+            appendInt(batch, r.args[0]);
+            batch += " ms";
+            break;
+        case LOG_REPORT_SAVED:
+            batch += "Raport final salvat.";
+            break;
+    }
+    batch += '\n';
+}
@@ -9,39 +9,77 @@
 
 using namespace std;
 
-Point HiveMind::findNearestChargingPoint(const Point& position, const Map& map) const {
-    Point nearest = map.getBasePosition();
-    int minDist = Point::distance(position, nearest);
-    
-    // Verifică toate stațiile
-    for (const auto& station : map.getStations()) {
-        int dist = Point::distance(position, station);
-        if (dist < minDist) {
-            minDist = dist;
-            nearest = station;
-        }
+// Marja aplicata traseului agent -> baza -> client -> incarcator
+static const double ROUTE_SAFETY_FACTOR = 1.1;
+
+void PackageGrid::reset(int width, int height) {
+    for (int b : usedBuckets) buckets[b].clear();
+    usedBuckets.clear();
+    
+    int bx = (width + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    int by = (height + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    if (bx != bucketsX || by != bucketsY) {
+        bucketsX = bx;
+        bucketsY = by;
+        buckets.assign(bx * by, vector<Package*>());
     }
-    
-    return nearest;
 }
 
-bool HiveMind::needsCharging(const Agent* agent, const Point& destination, const Map& map) const {
-    Point base = map.getBasePosition();
-    Point nearestCharger = findNearestChargingPoint(destination, map);
+void PackageGrid::insert(Package* package) {
+    int b = (package->destCoord.y / BUCKET_SIZE) * bucketsX + package->destCoord.x / BUCKET_SIZE;
+    if (buckets[b].empty()) usedBuckets.push_back(b);
+    buckets[b].push_back(package);
+}
+
+template <typename Fn>
+void PackageGrid::forEachInBox(const Point& center, double radius, Fn fn) const {
+    if (radius < 0) return;
+    int r = static_cast<int>(radius);
+    int minX = max(0, (center.x - r) / BUCKET_SIZE);
+    int maxX = min(bucketsX - 1, (center.x + r) / BUCKET_SIZE);
+    int minY = max(0, (center.y - r) / BUCKET_SIZE);
+    int maxY = min(bucketsY - 1, (center.y + r) / BUCKET_SIZE);
+    
+    for (int by = minY; by <= maxY; by++) {
+        for (int bx = minX; bx <= maxX; bx++) {
+            for (Package* package : buckets[by * bucketsX + bx]) {
+                if (abs(package->destCoord.x - center.x) <= r &&
+                    abs(package->destCoord.y - center.y) <= r) {
+                    fn(package);
+                }
+            }
+        }
+    }
+}
 
-    double distToBase, distToDest, distToCharger;
+// Distanta de parcurs intre doua puncte, in functie de tipul agentului.
+// Dronele zboara in linie dreapta; robotii si scuterele folosesc drumul exact
+// precalculat in Map. Fara drum, distanta e infinita.
+double HiveMind::travelDistance(const Agent* agent, const Point& from, const Point& to,
+                                const Map& map) const {
+    if (agent->getType() == DRONE) {
+        return map.getAirDistance(from, to);
+    }
+    int dist = map.getGroundDistance(from, to);
+    return dist < 0 ? numeric_limits<double>::infinity() : static_cast<double>(dist);
+}
 
+// Punctul de incarcare cel mai apropiat pe traseul pe care il urmeaza agentul:
+// dronele ignora zidurile, restul merg pe drumul real
+Point HiveMind::nearestCharger(const Agent* agent, const Point& from, const Map& map) const {
     if (agent->getType() == DRONE) {
-        // Euclidian pentru Drone
-        distToBase = std::hypot(base.x - agent->getPosition().x, base.y - agent->getPosition().y);
-        distToDest = std::hypot(destination.x - agent->getPosition().x, destination.y - agent->getPosition().y);
-        distToCharger = std::hypot(nearestCharger.x - destination.x, nearestCharger.y - destination.y);
-    } else {
-        // Manhattan pentru Roboți/Scutere
-        distToBase = Point::distance(agent->getPosition(), base);
-        distToDest = Point::distance(agent->getPosition(), destination);
-        distToCharger = Point::distance(destination, nearestCharger);
+        return map.getNearestAirCharger(from);
     }
+    return map.getNearestCharger(from);
+}
+
+bool HiveMind::needsCharging(const Agent* agent, const Point& destination, const Map& map) const {
+    Point base = map.getBasePosition();
+    Point charger = nearestCharger(agent, destination, map);
+
+    double distToBase = travelDistance(agent, agent->getPosition(), base, map);
+    double distToDest = travelDistance(agent, agent->getPosition(), destination, map);
+    double distToCharger = travelDistance(agent, destination, charger, map);
 
     double totalDist = (distToBase + distToDest + distToCharger);
     
@@ -52,23 +90,14 @@ bool HiveMind::needsCharging(const Agent* agent, const Point& destination, const
 }
 
 
-int HiveMind::estimateDeliveryTime(const Agent* agent, const Point& destination) const {
-
-    double distance;
-    
-    if(agent->getType() == DRONE){
-	//calculam distanta euclidiana, ca zburam pe diagonala
-	distance = std::hypot(destination.x - agent->getPosition().x, destination.y - agent->getPosition().y);
-    } else {
-	//manhattan
-	distance = static_cast<double>(Point::distance(agent->getPosition(), destination));
-    }
-
-    //pentru ca nu am apelat iar bfs sa vedem exact distanta, vom folosi o euristica
-    float pathFactor = (agent->getType() == DRONE) ? 1.0f : 1.3f;
-    
-    // Timp estimat = distanță * factor / viteză
-    return static_cast<int>(ceil((distance * pathFactor) / agent->getSpeed()));
+int HiveMind::estimateDeliveryTime(const Agent* agent, const Point& destination,
+                                   const Map& map) const {
+    // Distanta e exacta (drum BFS pentru sol, euclidiana pentru drone),
+    // deci nu mai e nevoie de factori de corectie
+    double distance = travelDistance(agent, agent->getPosition(), destination, map);
+    
+    // Timp estimat = distanță / viteză
+    return static_cast<int>(ceil(distance / agent->getSpeed()));
 }
 
 // Estimează costul livrării
@@ -78,58 +107,55 @@ double HiveMind::estimateDeliveryCost(const Agent* agent, int deliveryTime) cons
 }
 
 
+// Cat de departe de baza poate fi un client ca agentul sa mai treaca testul
+// de autonomie din calculateAssignmentScore. Distanta baza -> client e cel
+// putin cea in linie dreapta, deci orice pachet in afara patratului de
+// latura 2 * raza in jurul bazei e sigur respins. Negativ = nimic fezabil.
+double HiveMind::reachableRadius(const Agent* agent, double distToPickup) const {
+    double maxRange = (agent->getBattery() / agent->getConsumption()) * agent->getSpeed();
+    return maxRange / ROUTE_SAFETY_FACTOR - distToPickup;
+}
+
 double HiveMind::calculateAssignmentScore(Agent* agent, Package* package,
 const Map& map, int currentTick) const {
-    Point base = map.getBasePosition();
-    Point charger = findNearestChargingPoint(package->destCoord, map);
-    
-    double distToPickup, distToDeliver, distToSafety;
-    
-    if (agent->getType() == DRONE) {
-        // Dronele zboară în linie dreaptă (Euclidian)
-        distToPickup = std::hypot(base.x - agent->getPosition().x, base.y - agent->getPosition().y);
-        distToDeliver = std::hypot(package->destCoord.x - base.x, package->destCoord.y - base.y);
-        distToSafety = std::hypot(charger.x - package->destCoord.x, charger.y - package->destCoord.y);
-    } else {
+    double distToPickup = travelDistance(agent, agent->getPosition(), map.getBasePosition(), map);
+    ScoreTerms terms;
+    if (!scoreTerms(agent, package, map, distToPickup, terms)) return -1000.0;
+    return combineScore(agent, package, terms, currentTick);
+}
 
-        distToPickup = Point::distance(agent->getPosition(), base);
-        distToDeliver = Point::distance(base, package->destCoord);
-        distToSafety = Point::distance(package->destCoord, charger);
-    }
+// Distantele baza -> client -> incarcator vin din tabelul hartii. Agentul nu
+// sta pe un punct de interes, deci pentru drone distanta agent -> client
+// ramane singura calculata (hypot) per pereche.
+bool HiveMind::scoreTerms(const Agent* agent, const Package* package, const Map& map,
+                          double distToPickup, ScoreTerms& terms) const {
+    Point base = map.getBasePosition();
+    Point charger = nearestCharger(agent, package->destCoord, map);
     
-    // Factor de siguranță: 
-    // 1.1 pentru Drone (mică eroare de rotunjire)
-    // 2.0 pentru Roboți/Scutere (pentru a compensa ocolirea zidurilor generate procedural)
-    double safetyFactor = (agent->getType() == DRONE) ? 1.1 : 2.0;
+    double distToDeliver = travelDistance(agent, base, package->destCoord, map);
+    double distToSafety = travelDistance(agent, package->destCoord, charger, map);
     
-    double totalDistance = (distToPickup + distToDeliver + distToSafety) * safetyFactor;
+    // Factor de siguranță: distantele sunt exacte pentru toti agentii,
+    // ramane doar o marja mica pentru rotunjiri
+    double totalDistance = (distToPickup + distToDeliver + distToSafety) * ROUTE_SAFETY_FACTOR;
     
     double maxRange = (agent->getBattery() / agent->getConsumption()) * agent->getSpeed();
     
     if (totalDistance > maxRange) {
-        return -1000.0; 
+        return false; 
     }
     
     if (agent->getBatteryPercentage() < params.criticalBatteryThreshold) {
-        return -1000.0; 
+        return false; 
     }
     
     // Estimează timpul și costul
-    int deliveryTime = estimateDeliveryTime(agent, package->destCoord);
+    int deliveryTime = estimateDeliveryTime(agent, package->destCoord, map);
     double deliveryCost = estimateDeliveryCost(agent, deliveryTime);
     
     // Calculează profitul brut
-    double grossProfit = package->reward - deliveryCost;
-    
-    // Penalizare pentru întârziere
-    double delayPenalty = 0.0;
-    int timeUntilDeadline = package->deadline - currentTick;
-    
-     if (deliveryTime > timeUntilDeadline) {
-        delayPenalty = 50.0; 
-    }
-    
-    double netProfit = grossProfit - delayPenalty;
+    terms.grossProfit = package->reward - deliveryCost;
+    terms.deliveryTime = deliveryTime;
     
     // Factor de risc al bateriei (0 = sigur, 1 = riscant)
     float batteryRisk = 0.0f;
@@ -140,6 +166,31 @@ const Map& map, int currentTick) const {
     else if (batteryPercentageNeeded > 60) batteryRisk = 0.7f;
     else if (batteryPercentageNeeded > 40) batteryRisk = 0.4f;
     else if (batteryPercentageNeeded > 20) batteryRisk = 0.2f;
+    terms.batteryRisk = batteryRisk;
+    
+    // Distanța față de bază (preferă agenții apropriați)
+    terms.distanceFactor = 1.0;
+    int distToBase = Point::distance(agent->getPosition(), map.getBasePosition());
+    if (distToBase > 10) {
+        terms.distanceFactor = 0.8; // Preferă agenții apropiați de bază
+    }
+    
+    return true;
+}
+
+double HiveMind::combineScore(const Agent* agent, const Package* package, const ScoreTerms& terms,
+                              int currentTick) const {
+    int deliveryTime = terms.deliveryTime;
+    
+    // Penalizare pentru întârziere
+    double delayPenalty = 0.0;
+    int timeUntilDeadline = package->deadline - currentTick;
+    
+     if (deliveryTime > timeUntilDeadline) {
+        delayPenalty = 50.0; 
+    }
+    
+    double netProfit = terms.grossProfit - delayPenalty;
     
     // Factor de urgență
     double urgencyFactor = 1.0;
@@ -149,13 +200,6 @@ const Map& map, int currentTick) const {
         urgencyFactor = 1.5; // Urgent
     }
     
-    // Distanța față de bază (preferă agenții apropriați)
-    double distanceFactor = 1.0;
-    int distToBase = Point::distance(agent->getPosition(), map.getBasePosition());
-    if (distToBase > 10) {
-        distanceFactor = 0.8; // Preferă agenții apropiați de bază
-    }
-    
     // Scorul final (ponderat)
     double score = 0.0;
     
@@ -163,13 +207,13 @@ const Map& map, int currentTick) const {
     score += params.profitWeight * (netProfit / 800.0);
     
     // Siguranța bateriei (1 - risc)
-    score += params.safetyWeight * (1.0 - batteryRisk);
+    score += params.safetyWeight * (1.0 - terms.batteryRisk);
     
     // Urgența
     score += params.urgencyWeight * (urgencyFactor / (deliveryTime + 1));
     
     // Distanța
-    score += params.distanceWeight * distanceFactor;
+    score += params.distanceWeight * terms.distanceFactor;
     
     // Bonusuri specifice tipului de agent
     if (agent->getType() == ROBOT && package->reward < 400) {
@@ -184,95 +228,267 @@ const Map& map, int currentTick) const {
 }
 
 // Gestionează agenții cu baterie scăzută
-void HiveMind::handleLowBatteryAgents(vector<Agent*>& agents, const Map& map) {
+void HiveMind::handleLowBatteryAgents(Span<Agent*> agents, const Map& map) {
     for (auto agent : agents) {
         if (!agent->isAlive() || agent->getState() == CHARGING) continue;
         
         float batteryPercent = agent->getBatteryPercentage();
       
         if (batteryPercent < params.criticalBatteryThreshold) {
-            Point charger = findNearestChargingPoint(agent->getPosition(), map);
+            Point charger = nearestCharger(agent, agent->getPosition(), map);
+            Package* carried = agent->getPackage();
             agent->sendToCharge(charger);
+            if (carried) releasedPackages.push_back(carried);
         }
     }
 }
 
-// Atribuie pachetele agenților
-void HiveMind::assignPackages(vector<Agent*>& agents, vector<Package*>& packages,
-                             const Map& map, int currentTick) {
-    vector<AssignmentScore> allScores;
+// Compara starea curenta cu cea de la ultima planificare si marcheaza agentii
+// si pachetele murdare. Intoarce true daca exista ceva de replanificat.
+bool HiveMind::collectEvents(Span<Agent*> agents, Span<Package*> packages) {
+    bool dirty = false;
+    
+    for (Agent* agent : agents) {
+        int id = agent->getId();
+        if (id >= (int)agentById.size()) {
+            agentById.resize(id + 1, nullptr);
+            agentSnapshots.resize(id + 1);
+            agentDirty.resize(id + 1, 0);
+        }
+        agentById[id] = agent;
+        
+        AgentSnapshot now;
+        now.known = true;
+        now.alive = agent->isAlive();
+        now.free = now.alive && !agent->isBusy();
+        now.position = agent->getPosition();
+        now.battery = agent->getBattery();
+        
+        const AgentSnapshot& before = agentSnapshots[id];
+        bool becameIdle = now.free && (!before.known || !before.free);
+        bool died = before.alive && !now.alive;
+        // Pozitia si bateria intra in distante, autonomie si risc; orice
+        // schimbare (deplasare, incarcare, prag de baterie trecut) invalideaza
+        // scorurile agentului
+        bool changed = now.free && before.known &&
+                       (now.position != before.position || now.battery != before.battery);
+        
+        // Un agent care tocmai a primit pachet nu cere replanificare,
+        // dar scorurile lui din cache nu mai sunt valabile
+        agentDirty[id] = becameIdle || died || changed || (before.free && !now.free);
+        dirty = dirty || becameIdle || died || changed;
+        agentSnapshots[id] = now;
+    }
     
-    for (auto agent : agents) {
+    for (Package* package : packages) {
+        int id = package->id;
+        if (id >= (int)packageById.size()) {
+            packageById.resize(id + 1, nullptr);
+            packageWasPending.resize(id + 1, 0);
+            packageDirty.resize(id + 1, 0);
+        }
+        packageById[id] = package;
+        
+        bool pending = !package->assigned && !package->delivered;
+        bool appeared = pending && !packageWasPending[id]; // generat sau revenit in coada
+        packageDirty[id] = appeared || (packageWasPending[id] && !pending);
+        dirty = dirty || appeared;
+        packageWasPending[id] = pending;
+    }
+    
+    // Agentii morti nu mai apar in lista celor vii
+    if (agents.size() < lastAliveAgents) dirty = true;
+    lastAliveAgents = agents.size();
+    
+    return dirty;
+}
+
+void HiveMind::addScore(Agent* agent, Package* package, const Map& map, double distToPickup) {
+    ScoreTerms terms;
+    if (scoreTerms(agent, package, map, distToPickup, terms)) {
+        cachedScores.emplace_back(agent->getId(), package->id, terms);
+    }
+}
+
+// Scoate din cache perechile murdare si rescoreaza doar agentii/pachetele atinse.
+// Se scoreaza doar perechile care pot trece testul de autonomie.
+void HiveMind::refreshScores(Span<Agent*> agents, Span<Package*> packages, const Map& map) {
+    cachedScores.erase(remove_if(cachedScores.begin(), cachedScores.end(),
+                                 [this](const AssignmentScore& s) {
+                                     return agentDirty[s.agentId] || packageDirty[s.packageId];
+                                 }),
+                       cachedScores.end());
+    
+    pendingGrid.reset(map.getWidth(), map.getHeight());
+    dirtyPackages.clear();
+    for (Package* package : packages) {
+        if (package->assigned || package->delivered) continue;
+        pendingGrid.insert(package);
+        if (packageDirty[package->id]) dirtyPackages.push_back(package);
+    }
+    
+    Point base = map.getBasePosition();
+    
+    for (Agent* agent : agents) {
         if (!agent->isAlive() || agent->isBusy()) continue;
+        if (agent->getBatteryPercentage() < params.criticalBatteryThreshold) continue;
+        
+        double distToPickup = travelDistance(agent, agent->getPosition(), base, map);
+        double radius = reachableRadius(agent, distToPickup);
+        if (radius < 0) continue;
         
-        for (auto package : packages) {
-            if (package->assigned || package->delivered) continue;
-            
-            double score = calculateAssignmentScore(agent, package, map, currentTick);
-            
-            if (score > 0) { 
-                allScores.emplace_back(agent, package, score, 
-                                      package->reward - estimateDeliveryCost(agent, 
-                                      estimateDeliveryTime(agent, package->destCoord)),
-                                      estimateDeliveryTime(agent, package->destCoord),
-                                      static_cast<int>((estimateDeliveryTime(agent, package->destCoord) * 
-                                      agent->getConsumption() / agent->getBattery()) * 100));
+        if (agentDirty[agent->getId()]) {
+            pendingGrid.forEachInBox(base, radius, [&](Package* package) {
+                addScore(agent, package, map, distToPickup);
+            });
+        } else {
+            // Perechile curate sunt deja in cache
+            for (Package* package : dirtyPackages) {
+                if (abs(package->destCoord.x - base.x) <= radius &&
+                    abs(package->destCoord.y - base.y) <= radius) {
+                    addScore(agent, package, map, distToPickup);
+                }
             }
         }
     }
+}
+
+// Atribuie pachetele agenților
+void HiveMind::assignPackages(Span<Agent*> agents, Span<Package*> packages,
+                             const Map& map, int currentTick) {
+    // Fara evenimente si fara perechi fezabile in cache, rezultatul ar fi
+    // acelasi ca data trecuta. Perechile din cache se replanifica oricum:
+    // termenii dependenti de tick le pot schimba scorul si semnul.
+    if (!collectEvents(agents, packages) && cachedScores.empty()) return;
+    
+    refreshScores(agents, packages, map);
+    
+    // Perechile ai caror agent sau pachet nu mai sunt liberi ies si din cache.
+    // Un pachet conteaza doar daca e in asteptare in `packages`, nu si cand
+    // a fost eliberat dupa construirea listei.
+    size_t kept = 0;
+    for (size_t i = 0; i < cachedScores.size(); i++) {
+        const AssignmentScore& score = cachedScores[i];
+        Agent* agent = agentById[score.agentId];
+        if (agent->isAlive() && !agent->isBusy() && packageWasPending[score.packageId]) {
+            cachedScores[kept++] = score;
+        }
+    }
+    cachedScores.erase(cachedScores.begin() + kept, cachedScores.end());
+    
+    allScores.clear();
+    for (const AssignmentScore& cached : cachedScores) {
+        AssignmentScore score = cached;
+        score.score = combineScore(agentById[score.agentId], packageById[score.packageId],
+                                   score.terms, currentTick);
+        if (score.score > 0) allScores.push_back(score);
+    }
+    
+    if (assignmentMode == ASSIGN_OPTIMAL) {
+        selectOptimal();
+    } else {
+        selectGreedy();
+    }
     
-    // Sortează descrescător după scor
+    for (int idx : chosenScores) {
+        const AssignmentScore& score = allScores[idx];
+        Agent* agent = agentById[score.agentId];
+        Package* package = packageById[score.packageId];
+        
+        // Verifică dacă agentul are nevoie să se încarce înainte
+        if (needsCharging(agent, package->destCoord, map)) {
+            Point charger = nearestCharger(agent, agent->getPosition(), map);
+            agent->sendToCharge(charger);
+        } else {
+            agent->assignTask(package, map.getBasePosition());
+            package->assigned = true;
+            packageWasPending[package->id] = 0;
+        }
+    }
+}
+
+// Greedy: descrescator dupa scor, fiecare agent si pachet cel mult o data.
+// Egalitatile se rup dupa id-uri, ca alegerea sa nu depinda de ordinea din cache.
+void HiveMind::selectGreedy() {
     sort(allScores.begin(), allScores.end(),
          [](const AssignmentScore& a, const AssignmentScore& b) {
-             return a.score > b.score;
+             if (a.score != b.score) return a.score > b.score;
+             if (a.agentId != b.agentId) return a.agentId < b.agentId;
+             return a.packageId < b.packageId;
          });
     
-    // Atribuie folosind algoritm greedy
-    vector<bool> agentAssigned(agents.size(), false);
-    vector<bool> packageAssigned(packages.size(), false);
-    
-    for (const auto& score : allScores) {
-        // Găsește indexurile
-        int agentIdx = -1;
-        for (size_t i = 0; i < agents.size(); i++) {
-            if (agents[i] == score.agent) {
-                agentIdx = i;
-                break;
-            }
+    ArenaVector<char> agentAssigned(agentById.size(), 0, ArenaAllocator<char>(&scratch));
+    ArenaVector<char> packageAssigned(packageById.size(), 0, ArenaAllocator<char>(&scratch));
+    
+    chosenScores.clear();
+    for (size_t i = 0; i < allScores.size(); i++) {
+        const AssignmentScore& score = allScores[i];
+        if (!agentAssigned[score.agentId] && !packageAssigned[score.packageId]) {
+            agentAssigned[score.agentId] = true;
+            packageAssigned[score.packageId] = true;
+            chosenScores.push_back(i);
         }
+    }
+}
+
+// Optim: cuplaj de scor total maxim. Fiecare agent pastreaza doar cei mai
+// buni MAX_CANDIDATES_PER_AGENT candidati plus perechea aleasa de greedy,
+// ca graful sa ramana rar.
+void HiveMind::selectOptimal() {
+    const size_t MAX_CANDIDATES_PER_AGENT = 8;
+    
+    // Perechile alese de greedy intra mereu in graf. Altfel agentii identici
+    // (de exemplu parcati la baza) au aceiasi primi candidati si cuplajul
+    // ramane limitat la cativa agenti; asa, scorul total nu scade sub greedy.
+    selectGreedy();
+    ArenaVector<int> greedyPackage(agentById.size(), -1, ArenaAllocator<int>(&scratch));
+    for (int idx : chosenScores) greedyPackage[allScores[idx].agentId] = allScores[idx].packageId;
+    
+    // Grupam pe agent, descrescator dupa scor
+    sort(allScores.begin(), allScores.end(),
+         [](const AssignmentScore& a, const AssignmentScore& b) {
+             if (a.agentId != b.agentId) return a.agentId < b.agentId;
+             if (a.score != b.score) return a.score > b.score;
+             return a.packageId < b.packageId;
+         });
+    
+    // Indici locali compacti doar pentru agentii/pachetele care apar in muchii
+    ArenaVector<int> agentLocal(agentById.size(), -1, ArenaAllocator<int>(&scratch));
+    ArenaVector<int> packageLocal(packageById.size(), -1, ArenaAllocator<int>(&scratch));
+    int localAgents = 0;
+    int localPackages = 0;
+    
+    // Fiecare scor pastrat devine cel mult o muchie
+    ArenaVector<int> edgeScore{ArenaAllocator<int>(&scratch)}; // muchie -> index in allScores
+    edgeScore.reserve(allScores.size());
+    candidateEdges.clear();
+    size_t keptForAgent = 0;
+    
+    for (size_t i = 0; i < allScores.size(); i++) {
+        const AssignmentScore& score = allScores[i];
+        if (i == 0 || allScores[i - 1].agentId != score.agentId) keptForAgent = 0;
+        bool greedyPair = greedyPackage[score.agentId] == score.packageId;
+        if (keptForAgent++ >= MAX_CANDIDATES_PER_AGENT && !greedyPair) continue;
         
-        int packageIdx = -1;
-        for (size_t i = 0; i < packages.size(); i++) {
-            if (packages[i] == score.package) {
-                packageIdx = i;
-                break;
-            }
-        }
+        if (agentLocal[score.agentId] < 0) agentLocal[score.agentId] = localAgents++;
+        if (packageLocal[score.packageId] < 0) packageLocal[score.packageId] = localPackages++;
         
-        if (agentIdx != -1 && packageIdx != -1 &&
-            !agentAssigned[agentIdx] && !packageAssigned[packageIdx]) {
-            
-            // Verifică dacă agentul are nevoie să se încarce înainte
-            if (needsCharging(score.agent, score.package->destCoord, map)) {
-                Point charger = findNearestChargingPoint(score.agent->getPosition(), map);
-                score.agent->sendToCharge(charger);
-            } else {
-                score.agent->assignTask(score.package, map.getBasePosition());
-                score.package->assigned = true;
-            }
-            
-            agentAssigned[agentIdx] = true;
-            packageAssigned[packageIdx] = true;
-        }
+        candidateEdges.push_back({agentLocal[score.agentId], packageLocal[score.packageId], score.score});
+        edgeScore.push_back(i);
+    }
+    
+    chosenScores.clear();
+    for (int e : solver.solve(localAgents, localPackages, candidateEdges)) {
+        chosenScores.push_back(edgeScore[e]);
     }
 }
 
-void HiveMind::optimizeIdleAgents(vector<Agent*>& agents, const Map& map) {
+void HiveMind::optimizeIdleAgents(Span<Agent*> agents, const Map& map) {
     for (auto agent : agents) {
         if (!agent->isAlive() || agent->isBusy()) continue;
         
         if (agent->getState() == IDLE && agent->getBatteryPercentage() < 90.0f) {
-            Point charger = findNearestChargingPoint(agent->getPosition(), map);
+            Point charger = nearestCharger(agent, agent->getPosition(), map);
             if (agent->getPosition() != charger) {
                 agent->sendToCharge(charger);
             }
@@ -280,12 +496,45 @@ void HiveMind::optimizeIdleAgents(vector<Agent*>& agents, const Map& map) {
     }
 }
 
-void HiveMind::update(vector<Agent*>& agents, vector<Package*>& packages,
+void HiveMind::reset() {
+    cachedScores.clear();
+    releasedPackages.clear();
+    agentSnapshots.clear();
+    packageWasPending.clear();
+    agentDirty.clear();
+    packageDirty.clear();
+    agentById.clear();
+    packageById.clear();
+    dirtyPackages.clear();
+    lastAliveAgents = 0;
+}
+
+void HiveMind::update(Span<Agent*> agents, Span<Package*> packages,
                      const Map& map, int currentTick) {
+    Arena::Marker tickStart = scratch.mark();
+    uint64_t updateStart = profiler ? profiler->lastLap() : 0;
     
+    releasedPackages.clear();
     handleLowBatteryAgents(agents, map);
+    lap(PHASE_LOW_BATTERY);
+    
+    // Pachetele tocmai eliberate sunt inca in lista celor in curs a simularii;
+    // le planificam dupa cele din coada, in ordinea in care le-ar adauga
+    // syncPackageLists()
+    ArenaVector<Package*> pending{ArenaAllocator<Package*>(&scratch)};
+    if (!releasedPackages.empty()) {
+        pending.reserve(packages.size() + releasedPackages.size());
+        pending.insert(pending.end(), packages.begin(), packages.end());
+        pending.insert(pending.end(), releasedPackages.begin(), releasedPackages.end());
+        packages = Span<Package*>(pending);
+    }
     
     assignPackages(agents, packages, map, currentTick);
+    lap(PHASE_ASSIGN);
     
     optimizeIdleAgents(agents, map);
+    lap(PHASE_OPTIMIZE_IDLE);
+    
+    scratch.rewind(tickStart);
+    if (profiler) profiler->record(PHASE_HIVEMIND, profiler->lastLap() - updateStart);
 }
@@ -1,119 +1,441 @@
 #include "config.h"
 #include "simulation.h"
+#include "benchmarks.h"
+#include "alloccount.h"
+#include "scheduler.h"
+#include "mapcorpus.h"
+#include "trace.h"
+#include "profiler.h"
+#include "resultwriter.h"
+#include "sweep.h"
 #include <iostream>
 #include <vector>
 #include <thread>
-#include <mutex>
+#include <memory>
 #include <atomic>
 #include <chrono>
 #include <iomanip>
+#include <random>
+#include <string>
+#include <stdexcept>
 
 // BENCHMARK
 const int TOTAL_ITERATIONS = 100000; 
 
-std::mutex resultsMutex;
-long long globalProfit = 0;
-long long globalSurvivors = 0;
-long long globalDelivered = 0;
+// Optiunile din linia de comanda comune tuturor modurilor
+struct RunOptions {
+    PathfinderType pathfinderType = PATHFINDER_BFS;
+    AssignmentMode assignmentMode = ASSIGN_GREEDY;
+    int corpusSize = 0;                    // --corpus N, 0 = implicit pentru mod
+    unsigned long long seedBase = 0;       // --seed-base S
+    bool fixedSeed = false;                // altfel baza se alege aleator si se afiseaza
+    int mapCorpusSize = 0;                 // --map-corpus K: K harti partajate, 0 = harta proprie
+    std::string loadMapsPath;              // --load-maps FISIER
+    std::string saveMapsPath;              // --save-maps FISIER
+    std::string tracePath;                 // --trace FISIER: urma binara (benchmark: FISIER.<thread>)
+    bool profile = false;                  // --profile: histogramele de latenta ale fazelor
+    std::string resultsPath;               // --results FISIER: .csv sau .jsonl, o linie per simulare
+    std::vector<std::string> configPaths;  // --config FISIER, repetabil; scenariul i foloseste
+                                           // configuratia i % numar (implicit simulation_setup.txt)
+    std::string sweepSpecPath;             // --sweep-spec FISIER: intervalele parametrilor
+    int sweepCandidates = 64;              // --candidates N
+    bool sweepHalving = true;              // --search halving|random
+    unsigned int tickThreads = 1;          // --tick-threads N: agentii unui tick in paralel
+                                           // (rularea normala si --scaling)
+};
+
+std::vector<ScenarioConfig> loadConfigs(const RunOptions& options) {
+    std::vector<ScenarioConfig> configs;
+    if (options.configPaths.empty()) {
+        configs.push_back(ScenarioConfig::loadFromFile("../simulation_setup.txt"));
+    }
+    for (const auto& path : options.configPaths) {
+        configs.push_back(ScenarioConfig::loadFromFile(path));
+    }
+    return configs;
+}
+
+// Corpusul de harti cerut in optiuni: incarcat din fisier sau generat o data.
+// Gol daca fiecare simulare isi genereaza harta.
+MapCorpus prepareMapCorpus(const RunOptions& options, const std::vector<ScenarioConfig>& configs,
+                           unsigned int numThreads) {
+    MapCorpus corpus;
+    bool wantsCorpus = !options.loadMapsPath.empty() || options.mapCorpusSize > 0;
+    if (wantsCorpus && configs.size() > 1) {
+        throw std::invalid_argument("--map-corpus si --load-maps cer o singura configuratie");
+    }
+    if (!options.loadMapsPath.empty()) {
+        corpus = MapCorpus::load(options.loadMapsPath);
+        std::cout << "Harti incarcate: " << corpus.size() << " din " << options.loadMapsPath << std::endl;
+    } else if (options.mapCorpusSize > 0) {
+        auto start = std::chrono::high_resolution_clock::now();
+        corpus = MapCorpus::generate(configs[0], options.mapCorpusSize, options.seedBase, numThreads);
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Harti generate: " << corpus.size() << " in " << std::fixed
+                  << std::setprecision(2) << elapsed.count() << " secunde" << std::endl;
+    }
+    if (!options.saveMapsPath.empty() && !corpus.empty()) {
+        corpus.save(options.saveMapsPath);
+        std::cout << "Harti salvate in " << options.saveMapsPath << std::endl;
+    }
+    return corpus;
+}
+
+// Loturi mici: simularile au durate foarte diferite (moarte timpurie a
+// agentilor, reincercari la generarea hartii), iar furtul echilibreaza coada
+const int BENCHMARK_CHUNK = 64;
 
 std::atomic<int> progressCounter(0);
 
-void workerThread(int iterationsToRun) {
-    long long localProfit = 0;
-    long long localSurvivors = 0;
-    long long localDelivered = 0;
+// Totalurile scenariilor unei configuratii, cand benchmark-ul amesteca mai multe
+struct ConfigTotals {
+    int runs = 0;
+    long long profit = 0;
+    long long survivors = 0;
+    long long delivered = 0;
+};
+
+// Starea unui thread din pool: cate o simulare per configuratie, refolosita intre rulari
+struct BenchmarkWorker {
+    std::vector<std::unique_ptr<Simulation>> sims;
+    std::vector<ConfigTotals> perConfig;
+    std::unique_ptr<TraceWriter> trace;
+    std::unique_ptr<PhaseProfiler> profiler;
+    std::vector<SimulationResult> results;   // lotul curent, predat scriitorului
+    long long profit = 0;
+    long long survivors = 0;
+    long long delivered = 0;
+    long long allocations = 0;
+    int failed = 0;
+    unsigned long long digest = 0; // amprenta rezultatelor, independenta de ordine
+};
+
+// Amesteca rezultatul unui scenariu intr-o valoare de 64 de biti; suma lor
+// nu depinde de ordinea in care ruleaza scenariile
+static unsigned long long resultFingerprint(int index, long long profit, int delivered, int alive) {
+    unsigned long long z = (unsigned long long)index * 0x9E3779B97F4A7C15ULL;
+    z ^= (unsigned long long)profit * 0xBF58476D1CE4E5B9ULL;
+    z ^= ((unsigned long long)delivered << 32 | (unsigned int)alive) * 0x94D049BB133111EBULL;
+    z = (z ^ (z >> 31)) * 0xBF58476D1CE4E5B9ULL;
+    return z ^ (z >> 29);
+}
 
-    for (int i = 0; i < iterationsToRun; ++i) {
+Simulation& workerSimulation(BenchmarkWorker& worker, int configIndex,
+                             const std::vector<ScenarioConfig>& configs, const RunOptions& options) {
+    if (worker.sims.empty()) {
+        worker.sims.resize(configs.size());
+        worker.perConfig.resize(configs.size());
+        if (options.profile) worker.profiler.reset(new PhaseProfiler());
+    }
+
+    std::unique_ptr<Simulation>& sim = worker.sims[configIndex];
+    if (!sim) {
+        sim.reset(new Simulation(configs[configIndex], false, options.pathfinderType));
+        sim->setAssignmentMode(options.assignmentMode);
+        if (worker.trace) sim->setTrace(worker.trace.get());
+        if (worker.profiler) sim->setProfiler(worker.profiler.get());
+    }
+    return *sim;
+}
+
+void runBenchmarkChunk(BenchmarkWorker& worker, int begin, int end,
+                       const RunOptions& options, const std::vector<ScenarioConfig>& configs,
+                       const MapCorpus& maps, ResultWriter* results) {
+    for (int i = begin; i < end; ++i) {
+        size_t allocationsBefore = getThreadAllocationCount();
+        int configIndex = i % (int)configs.size();
         try {
-            Simulation sim(false); 
-            sim.initialize();
+            Simulation& sim = workerSimulation(worker, configIndex, configs, options);
+            sim.reset(Simulation::scenarioSeed(options.seedBase, i));
+            if (!maps.empty()) sim.setSharedMap(maps.get(i));
+            sim.initialize(i);
             sim.run();
 
-            localProfit += sim.getTotalProfit();
-            localSurvivors += sim.getAgentsAlive(); 
-            localDelivered += sim.getPackagesDelivered();
+            SimulationResult result = sim.getResult();
+            worker.profit += result.profit;
+            worker.survivors += result.agentsAlive;
+            worker.delivered += result.packagesDelivered;
+            worker.digest += resultFingerprint(i, result.profit, result.packagesDelivered,
+                                               result.agentsAlive);
+            ConfigTotals& totals = worker.perConfig[configIndex];
+            totals.runs++;
+            totals.profit += result.profit;
+            totals.survivors += result.agentsAlive;
+            totals.delivered += result.packagesDelivered;
+            if (results) worker.results.push_back(result);
 
         } catch (const std::exception& e) {
-            
+            worker.failed++;
         }
+        worker.allocations += getThreadAllocationCount() - allocationsBefore;
         
         progressCounter++;
     }
-
-    std::lock_guard<std::mutex> lock(resultsMutex);
-    globalProfit += localProfit;
-    globalSurvivors += localSurvivors;
-    globalDelivered += localDelivered;
+    if (results) results->submit(worker.results);
 }
 
-void runBenchmark() {
-    Config* config = Config::getInstance();
-    config->loadFromFile("../simulation_setup.txt");
+void runBenchmark(const RunOptions& options) {
+    std::vector<ScenarioConfig> configs = loadConfigs(options);
 
     unsigned int numThreads = std::thread::hardware_concurrency();
     if (numThreads == 0) numThreads = 4;
     
     std::cout << "--- BENCHMARK MULTI-THREADED ---" << std::endl;
     std::cout << "Sistem: " << numThreads << " nuclee CPU detectate." << std::endl;
-    std::cout << "Task: " << TOTAL_ITERATIONS << " simulari." << std::endl;
+    const int corpusSize = options.corpusSize > 0 ? options.corpusSize : TOTAL_ITERATIONS;
+    std::cout << "Task: " << corpusSize << " simulari (corpus seed-base " << options.seedBase
+              << (options.fixedSeed ? "" : ", aleator") << ")." << std::endl;
+
+    if (configs.size() > 1) {
+        std::cout << "Configuratii: " << configs.size() << ", alternate intre scenarii." << std::endl;
+    }
+
+    MapCorpus maps = prepareMapCorpus(options, configs, numThreads);
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    std::vector<std::thread> threads;
-    int iterationsPerThread = TOTAL_ITERATIONS / numThreads;
-    int remainder = TOTAL_ITERATIONS % numThreads;
+    std::unique_ptr<ResultWriter> results;
+    if (!options.resultsPath.empty()) {
+        results.reset(new ResultWriter(options.resultsPath));
+        if (!results->isOpen()) throw std::runtime_error("Nu pot crea " + options.resultsPath);
+    }
 
-    for (unsigned int i = 0; i < numThreads; ++i) {
-        int count = iterationsPerThread + (i == numThreads - 1 ? remainder : 0);
-        
-        threads.emplace_back(workerThread, count);
+    std::vector<BenchmarkWorker> workers(numThreads);
+    // Urmele se deschid aici, nu in thread-uri, ca o eroare sa opreasca
+    // benchmark-ul la fel ca in rularea normala
+    if (!options.tracePath.empty()) {
+        for (unsigned int w = 0; w < numThreads; w++) {
+            std::string path = options.tracePath + "." + std::to_string(w);
+            workers[w].trace.reset(new TraceWriter(path));
+            if (!workers[w].trace->isOpen()) throw std::runtime_error("Nu pot crea urma " + path);
+        }
     }
+    
+    WorkStealingScheduler scheduler(numThreads);
+    scheduler.start(corpusSize, BENCHMARK_CHUNK, [&](int worker, int begin, int end) {
+        runBenchmarkChunk(workers[worker], begin, end, options, configs, maps, results.get());
+    });
 
-    while (progressCounter < TOTAL_ITERATIONS) {
+    while (progressCounter < corpusSize) {
         int current = progressCounter.load();
-        int percent = (current * 100) / TOTAL_ITERATIONS;
+        int percent = (current * 100) / corpusSize;
         
-        std::cout << "\rProgres: [" << percent << "%] " << current << "/" << TOTAL_ITERATIONS << std::flush;
+        std::cout << "\rProgres: [" << percent << "%] " << current << "/" << corpusSize << std::flush;
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
-        if (current >= TOTAL_ITERATIONS) break;
+        if (current >= corpusSize) break;
     }
-    std::cout << "\rProgres: [100%] " << TOTAL_ITERATIONS << "/" << TOTAL_ITERATIONS << " Done!" << std::endl;
+    std::cout << "\rProgres: [100%] " << corpusSize << "/" << corpusSize << " Done!" << std::endl;
 
-    for (auto& t : threads) {
-        if (t.joinable()) t.join();
+    scheduler.wait();
+    if (results) results->close();   // asteapta scrierea ultimelor rezultate
+    for (auto& worker : workers) {
+        if (worker.trace) worker.trace->close();
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = endTime - startTime;
 
+    long long totalProfit = 0, totalSurvivors = 0, totalDelivered = 0, totalAllocations = 0;
+    int totalFailed = 0;
+    unsigned long long digest = 0;
+    PhaseProfiler phases;
+    for (const auto& worker : workers) {
+        if (worker.profiler) phases.merge(*worker.profiler);
+        totalFailed += worker.failed;
+        digest += worker.digest;
+        totalProfit += worker.profit;
+        totalSurvivors += worker.survivors;
+        totalDelivered += worker.delivered;
+        totalAllocations += worker.allocations;
+    }
+
     std::cout << "\n========================================" << std::endl;
     std::cout << "REZULTATE FINALE (" << numThreads << " Threads)" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Timp Executie:       " << std::fixed << std::setprecision(2) << elapsed.count() << " secunde" << std::endl;
-    std::cout << "Viteza:              " << (int)(TOTAL_ITERATIONS / elapsed.count()) << " simulari/sec" << std::endl;
+    std::cout << "Viteza:              " << (int)(corpusSize / elapsed.count()) << " simulari/sec" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+    std::cout << "PROFIT MEDIU:        " << (double)totalProfit / corpusSize << std::endl;
+    std::cout << "SURVIVABILITY AVG:   " << (double)totalSurvivors / corpusSize << std::endl;
+    std::cout << "PACHETE LIVRATE AVG: " << (double)totalDelivered / corpusSize << std::endl;
+    if (allocationCountingEnabled()) {
+        std::cout << "ALOCARI / SIMULARE:  " << (double)totalAllocations / corpusSize << std::endl;
+    } else {
+        std::cout << "ALOCARI / SIMULARE:  nemasurat (build cu COUNT_ALLOCATIONS=1)" << std::endl;
+    }
+    std::cout << "SIMULARI ESUATE:     " << totalFailed << std::endl;
+    std::cout << "AMPRENTA CORPUS:     " << std::hex << digest << std::dec << std::endl;
+    if (!options.resultsPath.empty()) {
+        std::cout << "REZULTATE SCRISE IN: " << options.resultsPath << std::endl;
+    }
     std::cout << "----------------------------------------" << std::endl;
-    std::cout << "PROFIT MEDIU:        " << (double)globalProfit / TOTAL_ITERATIONS << std::endl;
-    std::cout << "SURVIVABILITY AVG:   " << (double)globalSurvivors / TOTAL_ITERATIONS << std::endl;
-    std::cout << "PACHETE LIVRATE AVG: " << (double)globalDelivered / TOTAL_ITERATIONS << std::endl;
+    std::cout << "THREAD  OCUPAT(s)  IDLE(%)  LOTURI  FURATE" << std::endl;
+    const auto& stats = scheduler.getStats();
+    for (size_t t = 0; t < stats.size(); t++) {
+        double wall = stats[t].busySeconds + stats[t].idleSeconds;
+        double idlePercent = wall > 0 ? 100.0 * stats[t].idleSeconds / wall : 0.0;
+        std::cout << std::setw(6) << t
+                  << std::setw(11) << stats[t].busySeconds
+                  << std::setw(9) << idlePercent
+                  << std::setw(8) << stats[t].chunksRun
+                  << std::setw(8) << stats[t].chunksStolen << std::endl;
+    }
+    if (configs.size() > 1) {
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << "CONFIGURATIE        SIMULARI  PROFIT MEDIU  SUPRAVIETUITORI  LIVRATE" << std::endl;
+        for (size_t c = 0; c < configs.size(); c++) {
+            ConfigTotals sum;
+            for (const auto& worker : workers) {
+                if (c >= worker.perConfig.size()) continue;
+                sum.runs += worker.perConfig[c].runs;
+                sum.profit += worker.perConfig[c].profit;
+                sum.survivors += worker.perConfig[c].survivors;
+                sum.delivered += worker.perConfig[c].delivered;
+            }
+            double runs = std::max(sum.runs, 1);
+            std::cout << std::left << std::setw(18) << configs[c].label() << std::right
+                      << std::setw(10) << sum.runs
+                      << std::setw(14) << sum.profit / runs
+                      << std::setw(17) << sum.survivors / runs
+                      << std::setw(9) << sum.delivered / runs << std::endl;
+        }
+    }
+    if (options.profile) {
+        std::cout << "----------------------------------------" << std::endl;
+        std::cout << "LATENTA FAZELOR PE TICK (toate thread-urile)" << std::endl;
+        phases.print(std::cout);
+    }
     std::cout << "========================================" << std::endl;
 }
 
-void runNormal() {
-    Config* config = Config::getInstance();
-    config->loadFromFile("../simulation_setup.txt");
-    Simulation sim(true); 
+void runSweep(const RunOptions& options) {
+    std::vector<ScenarioConfig> configs = loadConfigs(options);
+
+    SweepSettings settings;
+    settings.numThreads = std::thread::hardware_concurrency();
+    if (settings.numThreads == 0) settings.numThreads = 4;
+    settings.candidates = options.sweepCandidates;
+    settings.successiveHalving = options.sweepHalving;
+    if (options.corpusSize > 0) settings.corpusSize = options.corpusSize;
+    settings.seedBase = options.seedBase;
+    settings.specPath = options.sweepSpecPath;
+    settings.pathfinderType = options.pathfinderType;
+    settings.assignmentMode = options.assignmentMode;
+
+    MapCorpus maps = prepareMapCorpus(options, configs, settings.numThreads);
+    runParameterSweep(settings, configs, maps);
+}
+
+void runNormal(const RunOptions& options) {
+    std::vector<ScenarioConfig> configs = loadConfigs(options);
+    configs.resize(1);   // o rulare normala foloseste prima configuratie
+    Simulation sim(configs[0], true, options.pathfinderType);
+    sim.setAssignmentMode(options.assignmentMode);
+    sim.setTickThreads(options.tickThreads);
+    // Cu --seed-base rulam scenariul 0 din corpusul benchmark-ului
+    if (options.fixedSeed) sim.reset(Simulation::scenarioSeed(options.seedBase, 0));
+    MapCorpus maps = prepareMapCorpus(options, configs, std::thread::hardware_concurrency());
+    if (!maps.empty()) sim.setSharedMap(maps.get(0));
+    std::unique_ptr<TraceWriter> trace;
+    if (!options.tracePath.empty()) {
+        trace.reset(new TraceWriter(options.tracePath));
+        if (!trace->isOpen()) throw std::runtime_error("Nu pot crea urma " + options.tracePath);
+        sim.setTrace(trace.get());
+    }
+    PhaseProfiler phases;
+    if (options.profile) sim.setProfiler(&phases);
+    sim.setReportPath("simulation_report.txt");
     sim.initialize();
     sim.run();
+    if (trace) trace->close();
     sim.printFinalReport();
+    if (options.profile) {
+        std::cout << "\nLATENTA FAZELOR PE TICK" << std::endl;
+        phases.print(std::cout);
+    }
+}
+
+PathfinderType parsePathfinder(const std::string& name) {
+    if (name == "bfs") return PATHFINDER_BFS;
+    if (name == "astar") return PATHFINDER_ASTAR;
+    if (name == "jps") return PATHFINDER_JPS;
+    throw std::invalid_argument("Pathfinder necunoscut: " + name + " (bfs, astar, jps)");
+}
+
+AssignmentMode parseAssignmentMode(const std::string& name) {
+    if (name == "greedy") return ASSIGN_GREEDY;
+    if (name == "optimal") return ASSIGN_OPTIMAL;
+    throw std::invalid_argument("Mod de atribuire necunoscut: " + name + " (greedy, optimal)");
 }
 
 int main(int argc, char* argv[]) {
     try {
-        if (argc > 1 && std::string(argv[1]) == "--benchmark") {
-            runBenchmark();
+        std::string mode;
+        RunOptions options;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--pathfinder" && i + 1 < argc) {
+                options.pathfinderType = parsePathfinder(argv[++i]);
+            } else if (arg == "--assign" && i + 1 < argc) {
+                options.assignmentMode = parseAssignmentMode(argv[++i]);
+            } else if (arg == "--seed-base" && i + 1 < argc) {
+                options.seedBase = std::stoull(argv[++i]);
+                options.fixedSeed = true;
+            } else if (arg == "--map-corpus" && i + 1 < argc) {
+                options.mapCorpusSize = std::stoi(argv[++i]);
+            } else if (arg == "--load-maps" && i + 1 < argc) {
+                options.loadMapsPath = argv[++i];
+            } else if (arg == "--save-maps" && i + 1 < argc) {
+                options.saveMapsPath = argv[++i];
+            } else if (arg == "--trace" && i + 1 < argc) {
+                options.tracePath = argv[++i];
+            } else if (arg == "--config" && i + 1 < argc) {
+                options.configPaths.push_back(argv[++i]);
+            } else if (arg == "--sweep-spec" && i + 1 < argc) {
+                options.sweepSpecPath = argv[++i];
+            } else if (arg == "--candidates" && i + 1 < argc) {
+                options.sweepCandidates = std::stoi(argv[++i]);
+                if (options.sweepCandidates <= 0) throw std::invalid_argument("--candidates trebuie sa fie pozitiv");
+            } else if (arg == "--search" && i + 1 < argc) {
+                std::string search = argv[++i];
+                if (search != "halving" && search != "random") {
+                    throw std::invalid_argument("Cautare necunoscuta: " + search + " (halving, random)");
+                }
+                options.sweepHalving = search == "halving";
+            } else if (arg == "--results" && i + 1 < argc) {
+                options.resultsPath = argv[++i];
+            } else if (arg == "--tick-threads" && i + 1 < argc) {
+                int threads = std::stoi(argv[++i]);
+                if (threads <= 0) throw std::invalid_argument("--tick-threads trebuie sa fie pozitiv");
+                options.tickThreads = (unsigned int)threads;
+            } else if (arg == "--profile") {
+                options.profile = true;
+            } else if (arg == "--corpus" && i + 1 < argc) {
+                options.corpusSize = std::stoi(argv[++i]);
+                if (options.corpusSize <= 0) throw std::invalid_argument("--corpus trebuie sa fie pozitiv");
+            } else {
+                mode = arg;
+            }
+        }
+
+        if (!options.fixedSeed) options.seedBase = std::random_device{}();
+
+        if (mode == "--benchmark") {
+            runBenchmark(options);
+        } else if (mode == "--sweep") {
+            runSweep(options);
+        } else if (mode == "--bench-path") {
+            runPathfindingBenchmark();
+        } else if (mode == "--bench-assign") {
+            runAssignmentBenchmark(options.seedBase);
+        } else if (mode == "--scaling") {
+            runScalingBenchmark(options.tickThreads);
+        } else if (mode == "--bench-mapgen") {
+            runMapGenerationBenchmark();
         } else {
-            runNormal();
+            runNormal(options);
         }
         return 0;
     } catch (const std::exception& e) {
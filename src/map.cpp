@@ -1,22 +1,57 @@
 #include "map.h"
 #include "config.h"
 #include <iostream>
+#include <istream>
+#include <ostream>
 #include <queue>
 #include <random>
 #include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Prag (surse x celule) peste care campurile se calculeaza in paralel
+static const long long PARALLEL_FIELDS_MIN_CELLS = 1 << 20;
 
 void Map::init(int h, int w) {
     height = h;
     width = w;
-    grid.clear();
     clients.clear();
     stations.clear();
-    for (int i = 0; i < h; i++) grid.push_back(std::string(w, CELL_EMPTY));
+    fieldTargets.clear();
+    fieldOfCell.clear();
+    distanceFields.clear();
+    poiGroundDistances.clear();
+    poiAirDistances.clear();
+    // Randurile existente se refolosesc cand harta e regenerata
+    grid.resize(h);
+    for (int i = 0; i < h; i++) grid[i].assign(w, CELL_EMPTY);
+
+    wordsPerRow = 1 + (w + 63) / 64;
+    // +1 cuvant final: celula (width, height) cade dupa ultimul rand de padding
+    // cand latimea e multiplu de 64
+    walkable.assign((h + 2) * wordsPerRow + 1, 0);
+    for (int y = 0; y < h; y++) {
+        uint64_t* row = &walkable[(y + 1) * wordsPerRow + 1];
+        for (int x = 0; x < w; x += 64) {
+            int bits = std::min(64, w - x);
+            row[x >> 6] = bits == 64 ? ~0ULL : ((1ULL << bits) - 1);
+        }
+    }
 }
 
 void Map::setCell(int x, int y, char type) {
     if (isValidCoord(x, y)) {
         grid[y][x] = type;
+
+        int bit = x + 64;
+        uint64_t mask = 1ULL << (bit & 63);
+        uint64_t& word = walkable[(y + 1) * wordsPerRow + (bit >> 6)];
+        if (type == CELL_WALL) word &= ~mask;
+        else word |= mask;
         if (type == CELL_BASE) { startX = x; startY = y; }
         if (type == CELL_CLIENT) clients.push_back({x, y});
         if (type == CELL_STATION) stations.push_back({x, y});
@@ -36,82 +71,544 @@ void Map::print() const {
     for (const auto& row : grid) std::cout << row << "\n";
 }
 
-int ProceduralMapGenerator::getRandom(int min, int max) {
-    thread_local static std::mt19937
-    rng(std::random_device{}());
+void Map::buildDistanceFields() {
+    int area = height * width;
+
+    fieldTargets.clear();
+    fieldTargets.push_back(getBasePosition());
+    fieldTargets.insert(fieldTargets.end(), clients.begin(), clients.end());
+    fieldTargets.insert(fieldTargets.end(), stations.begin(), stations.end());
+
+    size_t n = fieldTargets.size();
+    fieldOfCell.assign(area, -1);
+    distanceFields.assign(n * area, -1);
+    for (size_t f = 0; f < n; f++) {
+        fieldOfCell[fieldTargets[f].y * width + fieldTargets[f].x] = (int)f;
+    }
+
+    // Sursele sunt independente, asa ca pe hartile mari le impartim pe thread-uri.
+    // Pe hartile mici costul pornirii thread-urilor depaseste castigul.
+    unsigned int numThreads = std::thread::hardware_concurrency();
+    if (numThreads > n) numThreads = n;
+    if (numThreads > 1 && (long long)n * area >= PARALLEL_FIELDS_MIN_CELLS) {
+        std::vector<std::thread> workers;
+        size_t chunk = (n + numThreads - 1) / numThreads;
+        for (size_t first = 0; first < n; first += chunk) {
+            workers.emplace_back(&Map::buildFieldRange, this, first, std::min(n, first + chunk));
+        }
+        for (auto& t : workers) t.join();
+    } else {
+        buildFieldRange(0, n);
+    }
+
+    poiGroundDistances.assign(n * n, -1);
+    poiAirDistances.assign(n * n, 0.0);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            poiGroundDistances[i * n + j] = getFieldDistance((int)j, fieldTargets[i]);
+            poiAirDistances[i * n + j] = std::hypot(fieldTargets[j].x - fieldTargets[i].x,
+                                                    fieldTargets[j].y - fieldTargets[i].y);
+        }
+    }
+
+    buildNearestChargers();
+}
+
+void Map::buildNearestChargers() {
+    int area = height * width;
+    std::vector<Point> chargers;
+    chargers.push_back(getBasePosition());
+    chargers.insert(chargers.end(), stations.begin(), stations.end());
+
+    // BFS cu toate sursele in coada de la inceput: prima sursa care atinge o
+    // celula e cea mai apropiata. La egalitate castiga ordinea baza, statii.
+    std::vector<int> owner(area, -1);
+    std::vector<int> q_vec(area);
+    int head = 0, tail = 0;
+    for (size_t c = 0; c < chargers.size(); c++) {
+        int idx = chargers[c].y * width + chargers[c].x;
+        if (owner[idx] != -1) continue;
+        owner[idx] = (int)c;
+        q_vec[tail++] = idx;
+    }
+
+    const int dx[] = {0, 0, -1, 1};
+    const int dy[] = {-1, 1, 0, 0};
+    while (head < tail) {
+        int currentIdx = q_vec[head++];
+        int cx = currentIdx % width;
+        int cy = currentIdx / width;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+            if (!isWalkable(nx, ny)) continue;
+
+            int nIdx = ny * width + nx;
+            if (owner[nIdx] == -1) {
+                owner[nIdx] = owner[currentIdx];
+                q_vec[tail++] = nIdx;
+            }
+        }
+    }
+
+    nearestCharger.resize(area);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int idx = y * width + x;
+            if (owner[idx] != -1) {
+                nearestCharger[idx] = chargers[owner[idx]];
+                continue;
+            }
+            Point p = {x, y};
+            Point best = chargers[0];
+            int minDist = Point::distance(p, best);
+            for (size_t c = 1; c < chargers.size(); c++) {
+                int dist = Point::distance(p, chargers[c]);
+                if (dist < minDist) {
+                    minDist = dist;
+                    best = chargers[c];
+                }
+            }
+            nearestCharger[idx] = best;
+        }
+    }
+
+    // Dronele zboara peste pereti, deci pentru ele conteaza distanta Manhattan.
+    // A doua trecere ignora peretii; pe acelasi nivel o celula pastreaza sursa
+    // cu indicele cel mai mic, exact ca o cautare liniara cu comparatie stricta.
+    std::vector<int> airOwner(area, -1);
+    std::vector<int> airDist(area, -1);
+    head = tail = 0;
+    for (size_t c = 0; c < chargers.size(); c++) {
+        int idx = chargers[c].y * width + chargers[c].x;
+        if (airOwner[idx] != -1) continue;
+        airOwner[idx] = (int)c;
+        airDist[idx] = 0;
+        q_vec[tail++] = idx;
+    }
+
+    while (head < tail) {
+        int currentIdx = q_vec[head++];
+        int cx = currentIdx % width;
+        int cy = currentIdx / width;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int nIdx = ny * width + nx;
+            if (airOwner[nIdx] == -1) {
+                airOwner[nIdx] = airOwner[currentIdx];
+                airDist[nIdx] = airDist[currentIdx] + 1;
+                q_vec[tail++] = nIdx;
+            } else if (airDist[nIdx] == airDist[currentIdx] + 1 && airOwner[currentIdx] < airOwner[nIdx]) {
+                airOwner[nIdx] = airOwner[currentIdx];
+            }
+        }
+    }
+
+    nearestAirCharger.resize(area);
+    for (int idx = 0; idx < area; idx++) nearestAirCharger[idx] = chargers[airOwner[idx]];
+}
+
+// Vectori de tipuri simple: lungimea urmata de elemente, octet cu octet
+template <typename T>
+static void writeVector(std::ostream& out, const std::vector<T>& v) {
+    uint64_t n = v.size();
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(v.data()), n * sizeof(T));
+}
+
+// `expected` e lungimea exacta; cu exact=false doar o limita superioara
+template <typename T>
+static void readVector(std::istream& in, std::vector<T>& v, uint64_t expected, bool exact = true) {
+    uint64_t n = 0;
+    in.read(reinterpret_cast<char*>(&n), sizeof(n));
+    if (!in || (exact ? n != expected : n > expected)) throw std::runtime_error("Eroare: Harta salvata este corupta.");
+    v.resize(n);
+    in.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+}
+
+void Map::write(std::ostream& out) const {
+    int32_t header[5] = {height, width, startX, startY, wordsPerRow};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (const auto& row : grid) out.write(row.data(), width);
+    writeVector(out, clients);
+    writeVector(out, stations);
+    writeVector(out, walkable);
+    writeVector(out, fieldTargets);
+    writeVector(out, fieldOfCell);
+    writeVector(out, distanceFields);
+    writeVector(out, poiGroundDistances);
+    writeVector(out, poiAirDistances);
+    writeVector(out, nearestCharger);
+    writeVector(out, nearestAirCharger);
+}
+
+void Map::read(std::istream& in) {
+    int32_t header[5];
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || header[0] <= 0 || header[1] <= 0) {
+        throw std::runtime_error("Eroare: Harta salvata este corupta.");
+    }
+    height = header[0];
+    width = header[1];
+    startX = header[2];
+    startY = header[3];
+    wordsPerRow = header[4];
+    if (wordsPerRow != 1 + (width + 63) / 64) {
+        throw std::runtime_error("Eroare: Harta salvata este corupta.");
+    }
+
+    uint64_t area = (uint64_t)height * width;
+    grid.resize(height);
+    for (auto& row : grid) {
+        row.resize(width);
+        in.read(&row[0], width);
+    }
+
+    readVector(in, clients, area, false);
+    readVector(in, stations, area, false);
+
+    uint64_t pois = 1 + clients.size() + stations.size();
+    readVector(in, walkable, (uint64_t)(height + 2) * wordsPerRow + 1);
+    readVector(in, fieldTargets, pois);
+    readVector(in, fieldOfCell, area);
+    readVector(in, distanceFields, pois * area);
+    readVector(in, poiGroundDistances, pois * pois);
+    readVector(in, poiAirDistances, pois * pois);
+    readVector(in, nearestCharger, area);
+    readVector(in, nearestAirCharger, area);
+    if (!in) throw std::runtime_error("Eroare: Harta salvata este corupta.");
+
+    // Indicii din fisier se folosesc la rulare fara verificari, deci orice
+    // punct din afara gridului sau camp inexistent opreste incarcarea aici
+    bool valid = isValidCoord(startX, startY);
+    for (const auto* points : {&clients, &stations, &fieldTargets, &nearestCharger, &nearestAirCharger}) {
+        for (const auto& p : *points) valid = valid && isValidCoord(p.x, p.y);
+    }
+    for (int field : fieldOfCell) valid = valid && field >= -1 && field < (int)pois;
+
+    // Bitboard-ul trebuie sa corespunda gridului, iar padding-ul sa fie gol:
+    // BFS-urile citesc vecinii de pe margine fara bounds check
+    std::vector<uint64_t> expected(walkable.size(), 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (grid[y][x] == CELL_WALL) continue;
+            int bit = x + 64;
+            expected[(y + 1) * wordsPerRow + (bit >> 6)] |= 1ULL << (bit & 63);
+        }
+    }
+    valid = valid && expected == walkable;
+    if (!valid) throw std::runtime_error("Eroare: Harta salvata este corupta.");
+}
+
+void Map::buildFieldRange(size_t first, size_t last) {
+    int area = height * width;
+    std::vector<int> q_vec(area);
+    const int dx[] = {0, 0, -1, 1};
+    const int dy[] = {-1, 1, 0, 0};
+
+    for (size_t f = first; f < last; f++) {
+        const Point& src = fieldTargets[f];
+        int srcIdx = src.y * width + src.x;
+
+        // BFS invers, din tinta spre toata harta
+        int* dist = &distanceFields[f * area];
+        int head = 0, tail = 0;
+        q_vec[tail++] = srcIdx;
+        dist[srcIdx] = 0;
+
+        while (head < tail) {
+            int currentIdx = q_vec[head++];
+            int cx = currentIdx % width;
+            int cy = currentIdx / width;
+
+            for (int i = 0; i < 4; i++) {
+                int nx = cx + dx[i];
+                int ny = cy + dy[i];
+                if (!isWalkable(nx, ny)) continue;
+
+                int nIdx = ny * width + nx;
+                if (dist[nIdx] == -1) {
+                    dist[nIdx] = dist[currentIdx] + 1;
+                    q_vec[tail++] = nIdx;
+                }
+            }
+        }
+    }
+}
+
+int Map::getFieldIndex(const Point& target) const {
+    if (fieldOfCell.empty() || !isValidCoord(target.x, target.y)) return -1;
+    return fieldOfCell[target.y * width + target.x];
+}
+
+int Map::getFieldDistance(int field, const Point& from) const {
+    return distanceFields[field * height * width + from.y * width + from.x];
+}
+
+bool Map::nextStepToward(const Point& from, const Point& target, Point& next) const {
+    int field = getFieldIndex(target);
+    if (field < 0) return false;
+
+    const int* dist = &distanceFields[field * height * width];
+    int d = dist[from.y * width + from.x];
+    if (d <= 0) return false; // deja la tinta sau inaccesibil
+
+    const int dx[] = {0, 0, -1, 1};
+    const int dy[] = {-1, 1, 0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        int nx = from.x + dx[i];
+        int ny = from.y + dy[i];
+        if (isValidCoord(nx, ny) && dist[ny * width + nx] == d - 1) {
+            next = {nx, ny};
+            return true;
+        }
+    }
+    return false;
+}
+
+// Un pas de expandare a frontierei pe tot bitboard-ul: fiecare celula atinsa
+// se propaga in cei 4 vecini, apoi se mascheaza cu celulele accesibile.
+// Intoarce true daca s-a atins cel putin o celula noua.
+static bool expandReached(const uint64_t* walk, const uint64_t* cur, uint64_t* next,
+                          size_t begin, size_t end, size_t stride) {
+    uint64_t changed = 0;
+    size_t i = begin;
+
+#ifdef __AVX2__
+    __m256i changedVec = _mm256_setzero_si256();
+    for (; i + 4 <= end; i += 4) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(cur + i));
+        __m256i left = _mm256_or_si256(_mm256_slli_epi64(c, 1),
+                       _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)(cur + i - 1)), 63));
+        __m256i right = _mm256_or_si256(_mm256_srli_epi64(c, 1),
+                        _mm256_slli_epi64(_mm256_loadu_si256((const __m256i*)(cur + i + 1)), 63));
+        __m256i up = _mm256_loadu_si256((const __m256i*)(cur + i - stride));
+        __m256i down = _mm256_loadu_si256((const __m256i*)(cur + i + stride));
+
+        __m256i n = _mm256_or_si256(_mm256_or_si256(c, left), _mm256_or_si256(right, up));
+        n = _mm256_and_si256(_mm256_or_si256(n, down),
+                             _mm256_loadu_si256((const __m256i*)(walk + i)));
+        _mm256_storeu_si256((__m256i*)(next + i), n);
+        changedVec = _mm256_or_si256(changedVec, _mm256_xor_si256(n, c));
+    }
+    changed = !_mm256_testz_si256(changedVec, changedVec);
+#endif
+
+    for (; i < end; i++) {
+        uint64_t c = cur[i];
+        uint64_t n = c | (c << 1) | (cur[i - 1] >> 63) | (c >> 1) | (cur[i + 1] << 63)
+                   | cur[i - stride] | cur[i + stride];
+        n &= walk[i];
+        next[i] = n;
+        changed |= n ^ c;
+    }
+    return changed != 0;
+}
+
+// Flood fill bit-paralel din `from`. `reached` are aceeasi forma ca bitboard-ul
+// hartii; buffer-ul e refolosit intre apeluri.
+void Map::floodFill(const Point& from, std::vector<uint64_t>& reached) const {
+    static thread_local std::vector<uint64_t> scratch;
+
+    size_t total = walkable.size();
+    reached.assign(total, 0);
+    scratch.assign(total, 0);
+
+    int bit = from.x + 64;
+    reached[(from.y + 1) * wordsPerRow + (bit >> 6)] = 1ULL << (bit & 63);
+
+    size_t stride = wordsPerRow;
+    size_t begin = stride;
+    size_t end = (height + 1) * stride;
+
+    uint64_t* cur = reached.data();
+    uint64_t* next = scratch.data();
+    while (expandReached(walkable.data(), cur, next, begin, end, stride)) {
+        std::swap(cur, next);
+    }
+    // Dupa ultimul pas `next` == `cur`; rezultatul trebuie sa ajunga in `reached`
+    if (cur != reached.data()) std::copy(cur + begin, cur + end, reached.begin() + begin);
+}
+
+bool Map::isReached(const std::vector<uint64_t>& reached, const Point& p) const {
+    int bit = p.x + 64;
+    return (reached[(p.y + 1) * wordsPerRow + (bit >> 6)] >> (bit & 63)) & 1;
+}
+
+bool Map::allReachableFrom(const Point& from, const std::vector<Point>& targets) const {
+    static thread_local std::vector<uint64_t> reached;
+    floodFill(from, reached);
+    for (const auto& t : targets) {
+        if (!isReached(reached, t)) return false;
+    }
+    return true;
+}
+
+int Map::getPoiGroundDistance(int from, int to) const {
+    return poiGroundDistances[from * fieldTargets.size() + to];
+}
+
+double Map::getPoiAirDistance(int from, int to) const {
+    return poiAirDistances[from * fieldTargets.size() + to];
+}
+
+// Distanta exacta pe grid (-1 daca nu exista drum). Cel putin un capat trebuie
+// sa fie punct de interes; altfel cadem pe Manhattan, care e o limita inferioara.
+int Map::getGroundDistance(const Point& from, const Point& to) const {
+    int fromField = getFieldIndex(from);
+    int toField = getFieldIndex(to);
+    if (fromField >= 0 && toField >= 0) return getPoiGroundDistance(fromField, toField);
+    if (toField >= 0) return getFieldDistance(toField, from);
+    if (fromField >= 0) return getFieldDistance(fromField, to);
+    return Point::distance(from, to);
+}
+
+double Map::getAirDistance(const Point& from, const Point& to) const {
+    int fromField = getFieldIndex(from);
+    int toField = getFieldIndex(to);
+    if (fromField >= 0 && toField >= 0) return getPoiAirDistance(fromField, toField);
+    return std::hypot(to.x - from.x, to.y - from.y);
+}
+
+RandomMapGenerator::RandomMapGenerator() : rng(std::random_device{}()) {}
+
+int RandomMapGenerator::getRandom(int min, int max) {
     std::uniform_int_distribution<int> dist(min, max);
     return dist(rng);
 }
 
-bool ProceduralMapGenerator::validateMap(const Map& map) {
-    int h = map.getHeight();
+void RandomMapGenerator::placePointsOfInterest(Map& map, int clientsCount, int stationsCount) {
     int w = map.getWidth();
-    std::vector<std::vector<bool>> visited(h, std::vector<bool>(w, false));
-    std::queue<Point> q;
-    
-    q.push({map.startX, map.startY});
-    visited[map.startY][map.startX] = true;
+    int h = map.getHeight();
     
-    int targetsFound = 0;
-    int totalTargets = map.clients.size() + map.stations.size();
+    map.setCell(getRandom(0, w-1), getRandom(0, h-1), CELL_BASE);
     
-    int dx[] = {0, 0, -1, 1};
-    int dy[] = {-1, 1, 0, 0};
-
-    while (!q.empty()) {
-        Point curr = q.front();
-        q.pop();
+    for (int i=0; i<clientsCount; i++) {
+         int x, y;
+         do { x = getRandom(0, w-1); y = getRandom(0, h-1); } 
+         while (map.getCell(x,y) != CELL_EMPTY);
+         map.setCell(x, y, CELL_CLIENT);
+    }
+    for (int i=0; i<stationsCount; i++) {
+         int x, y;
+         do { x = getRandom(0, w-1); y = getRandom(0, h-1); } 
+         while (map.getCell(x,y) != CELL_EMPTY);
+         map.setCell(x, y, CELL_STATION);
+    }
+}
 
-        char cell = map.getCell(curr.x, curr.y);
-        if (cell == CELL_CLIENT || cell == CELL_STATION) targetsFound++;
+bool ProceduralMapGenerator::validateMap(const Map& map) {
+    static thread_local std::vector<uint64_t> reached;
+    map.floodFill(map.getBasePosition(), reached);
 
-        for (int i = 0; i < 4; i++) {
-            int nx = curr.x + dx[i];
-            int ny = curr.y + dy[i];
-            if (map.isValidCoord(nx, ny) && !visited[ny][nx] && map.getCell(nx, ny) != CELL_WALL) {
-                visited[ny][nx] = true;
-                q.push({nx, ny});
-            }
-        }
+    for (const auto& client : map.clients) {
+        if (!map.isReached(reached, client)) return false;
     }
-    return targetsFound == totalTargets;
+    for (const auto& station : map.stations) {
+        if (!map.isReached(reached, station)) return false;
+    }
+    return true;
 }
 
-void ProceduralMapGenerator::generate(Map& map) {
-    Config* cfg = Config::getInstance();
+void ProceduralMapGenerator::generate(Map& map, const ScenarioConfig& cfg) {
     bool valid = false;
     int attempts = 0;
     
     while (!valid && attempts < 2000) {
         attempts++;
-        map.init(cfg->mapHeight, cfg->mapWidth);
-        
-        map.setCell(getRandom(0, cfg->mapWidth-1), getRandom(0, cfg->mapHeight-1), CELL_BASE);
+        map.init(cfg.mapHeight, cfg.mapWidth);
         
-        for (int i=0; i<cfg->clientsCount; i++) {
-             int x, y;
-             do { x = getRandom(0, cfg->mapWidth-1); y = getRandom(0, cfg->mapHeight-1); } 
-             while (map.getCell(x,y) != CELL_EMPTY);
-             map.setCell(x, y, CELL_CLIENT);
-        }
-        for (int i=0; i<cfg->maxStations; i++) {
-             int x, y;
-             do { x = getRandom(0, cfg->mapWidth-1); y = getRandom(0, cfg->mapHeight-1); } 
-             while (map.getCell(x,y) != CELL_EMPTY);
-             map.setCell(x, y, CELL_STATION);
-        }
+        placePointsOfInterest(map, cfg.clientsCount, cfg.maxStations);
 
-        int walls = (cfg->mapHeight * cfg->mapWidth) * 0.2;
+        int walls = (cfg.mapHeight * cfg.mapWidth) * WALL_DENSITY;
         for (int i=0; i<walls; i++) {
-            int x = getRandom(0, cfg->mapWidth-1);
-            int y = getRandom(0, cfg->mapHeight-1);
+            int x = getRandom(0, cfg.mapWidth-1);
+            int y = getRandom(0, cfg.mapHeight-1);
             if (map.getCell(x, y) == CELL_EMPTY) map.setCell(x, y, CELL_WALL);
         }
 
         if (validateMap(map)) valid = true;
     }
+    lastAttempts = attempts;
 
     if (!valid) {
 	throw std::runtime_error("Eroare: Harta invalida dupa multiple incercari.");
     }
+
+    if (buildFields) map.buildDistanceFields();
+}
+
+// Drumul cu cele mai putine ziduri de la `from` pana la componenta bazei
+// (BFS 0-1: celulele libere costa 0, zidurile 1); zidurile de pe el se sterg
+void ConnectedMapGenerator::carvePathToBase(Map& map, const Point& from) {
+    int w = map.getWidth();
+    int area = w * map.getHeight();
+    
+    dist.assign(area, -1);
+    prev.assign(area, -1);
+    frontier.clear();
+    int start = from.y * w + from.x;
+    dist[start] = 0;
+    frontier.push_back(start);
+    
+    const int dx[] = {0, 0, -1, 1};
+    const int dy[] = {-1, 1, 0, 0};
+    int joined = -1; // prima celula din componenta bazei
+    while (!frontier.empty()) {
+        int c = frontier.front();
+        frontier.pop_front();
+        if (map.isReached(reached, Point{c % w, c / w})) {
+            joined = c;
+            break;
+        }
+        int cx = c % w, cy = c / w;
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + dx[d], ny = cy + dy[d];
+            if (!map.isValidCoord(nx, ny)) continue;
+            int n = ny * w + nx;
+            int cost = map.isWalkable(nx, ny) ? 0 : 1;
+            if (dist[n] != -1 && dist[n] <= dist[c] + cost) continue;
+            dist[n] = dist[c] + cost;
+            prev[n] = c;
+            if (cost == 0) frontier.push_front(n);
+            else frontier.push_back(n);
+        }
+    }
+    
+    for (int c = joined; c != -1; c = prev[c]) {
+        if (map.getCell(c % w, c / w) == CELL_WALL) map.setCell(c % w, c / w, CELL_EMPTY);
+    }
+}
+
+void ConnectedMapGenerator::generate(Map& map, const ScenarioConfig& cfg) {
+    map.init(cfg.mapHeight, cfg.mapWidth);
+    
+    placePointsOfInterest(map, cfg.clientsCount, cfg.maxStations);
+    
+    int walls = (cfg.mapHeight * cfg.mapWidth) * WALL_DENSITY;
+    for (int i=0; i<walls; i++) {
+        int x = getRandom(0, cfg.mapWidth-1);
+        int y = getRandom(0, cfg.mapHeight-1);
+        if (map.getCell(x, y) == CELL_EMPTY) map.setCell(x, y, CELL_WALL);
+    }
+    
+    // Reparam in loc sa aruncam harta: fiecare client sau statie izolata e
+    // legata de componenta bazei stergand cat mai putine ziduri
+    map.floodFill(map.getBasePosition(), reached);
+    for (int pass = 0; pass < 2; pass++) {
+        const std::vector<Point>& pois = pass == 0 ? map.clients : map.stations;
+        for (size_t i = 0; i < pois.size(); i++) {
+            if (map.isReached(reached, pois[i])) continue;
+            carvePathToBase(map, pois[i]);
+            map.floodFill(map.getBasePosition(), reached);
+        }
+    }
+    
+    if (buildFields) map.buildDistanceFields();
 }
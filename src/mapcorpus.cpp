@@ -0,0 +1,79 @@
+#include "mapcorpus.h"
+#include "scheduler.h"
+#include "simulation.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+static const char CORPUS_MAGIC[8] = {'H', 'M', 'M', 'A', 'P', 'S', '0', '2'};
+
+// Hartile folosesc alta ramura de seed-uri decat scenariile benchmark-ului
+static const unsigned long long MAP_SEED_SALT = 0x6D61702D636F7270ULL;
+
+MapCorpus MapCorpus::generate(const ScenarioConfig& config, int count, unsigned long long seedBase,
+                              unsigned int numThreads) {
+    vector<shared_ptr<Map>> generated(count);
+
+    WorkStealingScheduler scheduler(numThreads);
+    scheduler.start(count, 1, [&](int, int begin, int end) {
+        ConnectedMapGenerator generator;
+        for (int k = begin; k < end; k++) {
+            generator.seed(Simulation::scenarioSeed(seedBase ^ MAP_SEED_SALT, k));
+            shared_ptr<Map> map = make_shared<Map>();
+            try {
+                generator.generate(*map, config);
+                generated[k] = map;
+            } catch (const exception&) {
+                // raportat dupa wait(), din thread-ul apelant
+            }
+        }
+    });
+    scheduler.wait();
+
+    for (const auto& map : generated) {
+        if (!map) throw runtime_error("Eroare: Harta invalida dupa multiple incercari.");
+    }
+
+    MapCorpus corpus;
+    corpus.maps.assign(generated.begin(), generated.end());
+    return corpus;
+}
+
+void MapCorpus::save(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out.is_open()) {
+        throw runtime_error("Eroare: Nu pot crea fisierul " + path);
+    }
+    out.write(CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+    uint64_t count = maps.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& map : maps) map->write(out);
+    if (!out) {
+        throw runtime_error("Eroare: Scriere esuata in " + path);
+    }
+}
+
+MapCorpus MapCorpus::load(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Eroare: Nu pot deschide fisierul " + path);
+    }
+    char magic[sizeof(CORPUS_MAGIC)];
+    uint64_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || memcmp(magic, CORPUS_MAGIC, sizeof(magic)) != 0) {
+        throw runtime_error("Eroare: " + path + " nu este un corpus de harti.");
+    }
+
+    MapCorpus corpus;
+    for (uint64_t k = 0; k < count; k++) {
+        shared_ptr<Map> map = make_shared<Map>();
+        map->read(in);
+        corpus.maps.push_back(map);
+    }
+    return corpus;
+}
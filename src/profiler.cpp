@@ -0,0 +1,74 @@
+#include "profiler.h"
+#include <cstring>
+#include <iomanip>
+
+using namespace std;
+
+static const char* PHASE_NAMES[PHASE_COUNT] = {
+    "tick", "spawnPackages", "HiveMind::update", "  handleLowBattery", "  assignPackages",
+    "  optimizeIdle", "syncLists/assign", "updateAgents", "processDeliveries",
+    "syncLists/deliver", "checkAgentStatus"
+};
+
+const char* profilePhaseName(ProfilePhase phase) {
+    return phase < PHASE_COUNT ? PHASE_NAMES[phase] : "?";
+}
+
+void LatencyHistogram::clear() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    total = 0;
+    maxValue = 0;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKETS; i++) buckets[i] += other.buckets[i];
+    count += other.count;
+    total += other.total;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < (1 << SUB_BITS)) return (uint64_t)bucket;
+    int msb = (bucket >> SUB_BITS) + SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(bucket & ((1 << SUB_BITS) - 1));
+    uint64_t low = (1ULL << msb) | (sub << (msb - SUB_BITS));
+    return low + (1ULL << (msb - SUB_BITS)) - 1;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (count == 0) return 0;
+    uint64_t rank = (uint64_t)(p / 100.0 * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) return min(bucketUpperBound(i), maxValue);
+    }
+    return maxValue;
+}
+
+void PhaseProfiler::clear() {
+    for (auto& h : phases) h.clear();
+}
+
+void PhaseProfiler::merge(const PhaseProfiler& other) {
+    for (int i = 0; i < PHASE_COUNT; i++) phases[i].merge(other.phases[i]);
+}
+
+void PhaseProfiler::print(ostream& out) const {
+    double tickTotal = (double)phases[PHASE_TICK].getTotal();
+
+    out << left << setw(20) << "FAZA" << right
+        << setw(12) << "MASURATORI" << setw(10) << "MEDIE(ns)" << setw(9) << "P50"
+        << setw(9) << "P90" << setw(9) << "P99" << setw(11) << "MAX" << setw(9) << "%TICK" << "\n";
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        const LatencyHistogram& h = phases[i];
+        out << left << setw(20) << PHASE_NAMES[i] << right
+            << setw(12) << h.getCount()
+            << setw(10) << fixed << setprecision(0) << h.getMean()
+            << setw(9) << h.percentile(50) << setw(9) << h.percentile(90)
+            << setw(9) << h.percentile(99) << setw(11) << h.getMax()
+            << setw(8) << setprecision(1) << (tickTotal > 0 ? 100.0 * h.getTotal() / tickTotal : 0.0)
+            << "%\n";
+    }
+}
@@ -0,0 +1,106 @@
+#include "resultwriter.h"
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+
+static bool endsWith(const string& s, const string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+ResultWriter::ResultWriter(const string& _path)
+    : format(endsWith(_path, ".jsonl") || endsWith(_path, ".json") ? FORMAT_JSONL : FORMAT_CSV),
+      path(_path), out(_path) {
+    if (!out.is_open()) return;
+    buffer.reserve(WRITE_BYTES * 2);
+    if (format == FORMAT_CSV) {
+        buffer += "scenario,seed,map_width,map_height,ticks_run,agents_initial,agents_alive,agents_lost,"
+                  "drones_alive,robots_alive,scooters_alive,packages_generated,"
+                  "packages_delivered,packages_failed,revenue,costs,penalties,profit\n";
+    }
+    writer = thread(&ResultWriter::writerLoop, this);
+}
+
+ResultWriter::~ResultWriter() {
+    stop();
+}
+
+void ResultWriter::stop() {
+    if (writer.joinable()) {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_one();
+        writer.join();
+    }
+}
+
+void ResultWriter::close() {
+    stop();
+    if (writeFailed) throw runtime_error("Scriere esuata in " + path + "; rezultatele sunt incomplete");
+}
+
+void ResultWriter::submit(vector<SimulationResult>& batch) {
+    if (batch.empty()) return;
+    {
+        lock_guard<mutex> guard(lock);
+        queued.insert(queued.end(), batch.begin(), batch.end());
+    }
+    batch.clear();
+    ready.notify_one();
+}
+
+void ResultWriter::writerLoop() {
+    vector<SimulationResult> taken;
+    while (true) {
+        bool last;
+        {
+            unique_lock<mutex> guard(lock);
+            ready.wait(guard, [this] { return stopping || !queued.empty(); });
+            taken.swap(queued);
+            last = stopping;
+        }
+
+        for (const auto& r : taken) {
+            append(r);
+            if (buffer.size() >= WRITE_BYTES) {
+                if (!writeFailed) writeFailed = !out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        taken.clear();
+
+        // `stopping` a fost vazut impreuna cu ultima predare, deci coada e goala
+        if (last) break;
+    }
+    if (!writeFailed) writeFailed = !out.write(buffer.data(), buffer.size()) || !out.flush();
+    out.close();
+    if (out.fail()) writeFailed = true;
+}
+
+void ResultWriter::append(const SimulationResult& r) {
+    char line[512];
+    int n;
+    if (format == FORMAT_CSV) {
+        n = snprintf(line, sizeof(line), "%d,%u,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%lld,%lld,%lld,%lld\n",
+                     r.scenario, r.seed, r.mapWidth, r.mapHeight, r.ticksRun,
+                     r.agentsInitial, r.agentsAlive, r.agentsLost,
+                     r.aliveOfType[DRONE], r.aliveOfType[ROBOT], r.aliveOfType[SCOOTER],
+                     r.packagesGenerated, r.packagesDelivered, r.packagesFailed,
+                     r.revenue, r.costs, r.penalties, r.profit);
+    } else {
+        n = snprintf(line, sizeof(line),
+                     "{\"scenario\":%d,\"seed\":%u,\"map_width\":%d,\"map_height\":%d,\"ticks_run\":%d,\"agents_initial\":%d,"
+                     "\"agents_alive\":%d,\"agents_lost\":%d,\"drones_alive\":%d,"
+                     "\"robots_alive\":%d,\"scooters_alive\":%d,\"packages_generated\":%d,"
+                     "\"packages_delivered\":%d,\"packages_failed\":%d,\"revenue\":%lld,"
+                     "\"costs\":%lld,\"penalties\":%lld,\"profit\":%lld}\n",
+                     r.scenario, r.seed, r.mapWidth, r.mapHeight, r.ticksRun,
+                     r.agentsInitial, r.agentsAlive, r.agentsLost,
+                     r.aliveOfType[DRONE], r.aliveOfType[ROBOT], r.aliveOfType[SCOOTER],
+                     r.packagesGenerated, r.packagesDelivered, r.packagesFailed,
+                     r.revenue, r.costs, r.penalties, r.profit);
+    }
+    buffer.append(line, n);
+}
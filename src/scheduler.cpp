@@ -0,0 +1,159 @@
+#include "scheduler.h"
+#include <algorithm>
+
+using namespace std;
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned int numThreads) {
+    if (numThreads == 0) numThreads = 1;
+    for (unsigned int i = 0; i < numThreads; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    stats.resize(numThreads);
+    finishTimes.resize(numThreads);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    wait();
+}
+
+void WorkStealingScheduler::start(int total, int chunk, Body _body) {
+    wait();
+    body = move(_body);
+    if (chunk < 1) chunk = 1;
+
+    int numThreads = (int)queues.size();
+    int numChunks = (total + chunk - 1) / chunk;
+    for (int w = 0; w < numThreads; w++) {
+        // Blocuri contigue de loturi, ca fiecare thread sa inceapa pe zona lui
+        int firstChunk = (int)((long long)numChunks * w / numThreads);
+        int lastChunk = (int)((long long)numChunks * (w + 1) / numThreads);
+        queues[w]->ranges.clear();
+        for (int c = firstChunk; c < lastChunk; c++) {
+            queues[w]->ranges.push_back({c * chunk, min(total, (c + 1) * chunk)});
+        }
+        stats[w] = WorkerStats();
+    }
+
+    runStart = chrono::steady_clock::now();
+    for (int w = 0; w < numThreads; w++) {
+        threads.emplace_back(&WorkStealingScheduler::workerLoop, this, w);
+    }
+}
+
+void WorkStealingScheduler::wait() {
+    if (threads.empty()) return;
+    for (auto& t : threads) t.join();
+    threads.clear();
+
+    // Idle = cat a stat thread-ul fara lucru intre pornire si terminarea
+    // celui mai lent thread
+    chrono::steady_clock::time_point lastFinish = runStart;
+    for (const auto& finish : finishTimes) lastFinish = max(lastFinish, finish);
+    double wall = chrono::duration<double>(lastFinish - runStart).count();
+    for (auto& s : stats) s.idleSeconds = wall - s.busySeconds;
+}
+
+bool WorkStealingScheduler::popLocal(int worker, Range& range) {
+    WorkerQueue& queue = *queues[worker];
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.ranges.empty()) return false;
+    range = queue.ranges.back();
+    queue.ranges.pop_back();
+    return true;
+}
+
+bool WorkStealingScheduler::steal(int worker, Range& range) {
+    int numThreads = (int)queues.size();
+    for (int k = 1; k < numThreads; k++) {
+        WorkerQueue& victim = *queues[(worker + k) % numThreads];
+        lock_guard<mutex> guard(victim.lock);
+        if (victim.ranges.empty()) continue;
+        range = victim.ranges.front();
+        victim.ranges.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingScheduler::workerLoop(int worker) {
+    WorkerStats& s = stats[worker];
+    Range range;
+
+    while (true) {
+        bool stolen = false;
+        if (!popLocal(worker, range)) {
+            if (!steal(worker, range)) break;
+            stolen = true;
+        }
+
+        auto t0 = chrono::steady_clock::now();
+        body(worker, range.begin, range.end);
+        auto t1 = chrono::steady_clock::now();
+
+        s.busySeconds += chrono::duration<double>(t1 - t0).count();
+        s.chunksRun++;
+        if (stolen) s.chunksStolen++;
+    }
+
+    finishTimes[worker] = chrono::steady_clock::now();
+}
+
+ForkJoinPool::ForkJoinPool(unsigned int numParts)
+    : current(nullptr), generation(0), pending(0), stopping(false) {
+    for (unsigned int part = 1; part < numParts; part++) {
+        threads.emplace_back(&ForkJoinPool::workerLoop, this, (int)part);
+    }
+}
+
+ForkJoinPool::~ForkJoinPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+void ForkJoinPool::run(const Task& task) {
+    if (threads.empty()) {
+        task(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        current = &task;
+        pending = (int)threads.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    task(0);
+
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [this] { return pending == 0; });
+    current = nullptr;
+}
+
+void ForkJoinPool::workerLoop(int part) {
+    unsigned long long seen = 0;
+    while (true) {
+        const Task* task;
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            task = current;
+        }
+
+        (*task)(part);
+
+        bool last;
+        {
+            lock_guard<mutex> guard(lock);
+            last = --pending == 0;
+        }
+        if (last) finished.notify_one();
+    }
+}
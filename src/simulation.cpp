@@ -9,215 +9,231 @@
 
 using namespace std;
 
-Simulation::Simulation(bool enableLog) 
-    : currentTick(0), totalTicks(0),
+Simulation::Simulation(const ScenarioConfig& _config, bool enableLog, PathfinderType _pathfinderType) 
+    : config(_config),
+      packages(ArenaAllocator<Package*>(&arena)),
+      aliveAgents(ArenaAllocator<Agent*>(&arena)),
+      pendingPackages(ArenaAllocator<Package*>(&arena)),
+      inFlightPackages(ArenaAllocator<Package*>(&arena)),
+      finishedPackages(ArenaAllocator<Package*>(&arena)),
+      currentTick(0), totalTicks(0),
       totalRevenue(0), totalCosts(0), totalPenalties(0),
       packagesDelivered(0), packagesFailed(0),
       agentsLost(0), agentsAlive(0),
       enableLogging(enableLog) {
     
-    map.reset(new Map());
-    hiveMind.reset(new HiveMind());
-    mapGenerator.reset(new ProceduralMapGenerator());
+    ownMap = arena.create<Map>();
+    map = ownMap;
+    hiveMind = arena.create<HiveMind>(tickScratch);
+    mapGenerator = arena.create<ConnectedMapGenerator>();
+    runStart = arena.mark();
+    seed = random_device{}();
+    rng.seed(seed);
+    scenario = 0;
+    trace = nullptr;
+    profiler = nullptr;
+    pathfinderType = _pathfinderType;
+    pathfinder = PathfinderFactory::create(pathfinderType);
     
     if (enableLogging) {
-        logFile.open("simulation_log.txt");
+        logger.reset(new AsyncLogger("simulation_log.txt"));
+        if (!logger->isOpen()) logger.reset();
     }
 }
 
 Simulation::~Simulation() {
-    if (logFile.is_open()) {
-        logFile.close();
-    }
+    // Jurnalul se goleste si se inchide inainte ca arena sa elibereze restul
+    logger.reset();
 }
 
-void Simulation::logEvent(const string& message) {
-    if (enableLogging && logFile.is_open()) {
-        logFile << "[TICK " << currentTick << "] " << message << endl;
-    }
+// Goleste un vector din arena fara sa-i pastreze memoria, care urmeaza
+// sa fie refolosita dupa rewind
+template <typename T>
+static void discard(ArenaVector<T>& v) {
+    ArenaVector<T>(v.get_allocator()).swap(v);
 }
 
-void Simulation::initialize() {
-    Config* config = Config::getInstance();
-    
-    logEvent("=== INITIALIZARE SIMULARE ===");
+unsigned int Simulation::scenarioSeed(unsigned long long seedBase, int index) {
+    // splitmix64: seed-uri consecutive dau stari mt19937 necorelate
+    unsigned long long z = seedBase + 0x9E3779B97F4A7C15ULL * (unsigned long long)(index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (unsigned int)(z ^ (z >> 32));
+}
+
+void Simulation::reset(unsigned int seed) {
+    currentTick = 0;
+    totalTicks = 0;
+    totalRevenue = 0;
+    totalCosts = 0;
+    totalPenalties = 0;
+    packagesDelivered = 0;
+    packagesFailed = 0;
+    agentsLost = 0;
+    agentsAlive = 0;
     
-    mapGenerator->generate(*map);
-    totalTicks = config->maxTicks;
+    discard(packages);
+    discard(aliveAgents);
+    discard(pendingPackages);
+    discard(inFlightPackages);
+    discard(finishedPackages);
+    arena.rewind(runStart);
+    tickScratch.release();
     
-    generateInitialAgents();
+    hiveMind->reset();
+    sharedMap.reset();
     
-    logEvent("Simularea este gata să înceapă.");
+    this->seed = seed;
+    rng.seed(seed);
+    mapGenerator->seed(rng());
 }
 
-void Simulation::generateInitialAgents() {
-    Config* config = Config::getInstance();
-    Point basePos = map->getBasePosition();
+void Simulation::initialize(int scenario) {
+    this->scenario = scenario;
+    if (trace) trace->beginSimulation(scenario, seed);
     
-    int agentId = 0;
+    logEvent(LOG_INIT_STARTED);
     
-    for (int i = 0; i < config->dronesCount; i++) {
-        agents.push_back(std::unique_ptr<Agent>(AgentFactory::create(DRONE, agentId++, basePos.x, basePos.y)));
+    if (sharedMap) {
+        map = sharedMap.get();
+    } else {
+        mapGenerator->generate(*ownMap, config);
+        map = ownMap;
     }
+    totalTicks = config.maxTicks;
     
-    for (int i = 0; i < config->robotsCount; i++) {
-        agents.push_back(std::unique_ptr<Agent>(AgentFactory::create(ROBOT, agentId++, basePos.x, basePos.y)));
-    }
+    generateInitialAgents();
+    
+    // Listele de pachete cresc cel mult pana la totalPackages; le rezervam
+    // o data ca sa nu lasam copii abandonate in arena la fiecare crestere
+    size_t maxPackages = max(config.totalPackages, 0);
+    packages.reserve(maxPackages);
+    pendingPackages.reserve(maxPackages);
+    inFlightPackages.reserve(maxPackages);
+    finishedPackages.reserve(maxPackages);
     
-    for (int i = 0; i < config->scootersCount; i++) {
-        agents.push_back(std::unique_ptr<Agent>(AgentFactory::create(SCOOTER, agentId++, basePos.x, basePos.y)));
+    logEvent(LOG_INIT_READY);
+}
+
+void Simulation::generateInitialAgents() {
+    fleet.init(config.dronesCount, config.robotsCount, config.scootersCount,
+               map->getBasePosition());
+    fleet.setPathfinder(pathfinder.get());
+    
+    // Pointerii spre agenti raman valabili cat traieste flota
+    aliveAgents.clear();
+    aliveAgents.reserve(fleet.size());
+    for (int i = 0; i < fleet.size(); i++) {
+        aliveAgents.push_back(fleet.get(i));
     }
     
-    agentsAlive = agents.size();
-    logEvent("Creati " + to_string(agentsAlive) + " agenti initiali.");
+    agentsAlive = fleet.size();
+    logEvent(LOG_AGENTS_CREATED, agentsAlive);
 }
 
 void Simulation::spawnPackages() {
-    Config* config = Config::getInstance();
-    
     // Verifică dacă trebuie să genereze pachete
-    if (currentTick % config->spawnFrequency != 0) return;
-    if ((int)packages.size() >= config->totalPackages) return;
+    if (currentTick % config.spawnFrequency != 0) return;
+    if ((int)packages.size() >= config.totalPackages) return;
     
-    thread_local std::random_device rd;
-    thread_local std::mt19937 gen(rd());
-    static uniform_int_distribution<int> rewardDist(200, 800);
-    static uniform_int_distribution<int> deadlineDist(10, 20);
+    uniform_int_distribution<int> rewardDist(200, 800);
+    uniform_int_distribution<int> deadlineDist(10, 20);
     
     const vector<Point>& mapClients = map->getClients();
     if (mapClients.empty()) return;
     
     uniform_int_distribution<int> clientDist(0, (int)mapClients.size() - 1);
-    int clientIdx = clientDist(gen);
-    
-    auto newPackage = std::unique_ptr<Package>(new Package(
-        (int)packages.size(),
-        mapClients[clientIdx],
-        rewardDist(gen),
-        currentTick + deadlineDist(gen),
-        currentTick,
-        clientIdx
-    ));
-    
-    packages.push_back(std::move(newPackage));
-    
-    logEvent("Generat pachet " + to_string(packages.back()->id) + 
-             " cu reward " + to_string(packages.back()->reward) +
-             " si deadline la tick " + to_string(packages.back()->deadline));
-}
-
-void Simulation::updateAgents() {
-    for (auto& agent : agents) {
-        if (!agent->isAlive()) continue;
+    
+    for (int k = 0; k < config.packagesPerSpawn; k++) {
+        if ((int)packages.size() >= config.totalPackages) break;
         
-        Point pos = agent->getPosition();
-        char cell = map->getCell(pos.x, pos.y);
+        int clientIdx = clientDist(rng);
         
-        bool onChargingCell = (cell == CELL_BASE || cell == CELL_STATION);
-
-        // //debug pt drone
-	// if (agent->getType() == DRONE) {
-        //     double distToTarget = 0.0;
-        //     string statusTarget = "Idle";
-
-        //     // Calculam distanta daca are un pachet (targetul e destinatia pachetului)
-        //     if (agent->getPackage()) {
-        //         Point dest = agent->getPackage()->destCoord;
-        //         // Distanta Euclidiana
-        //         distToTarget = std::hypot(dest.x - pos.x, dest.y - pos.y);
-        //         statusTarget = "Livrare Pachet " + to_string(agent->getPackage()->id);
-        //     } 
-        //     // Optional: Daca nu are pachet dar se misca spre statie, ai putea calcula distanta pana acolo
-        //     // dar momentan ne concentram pe pachet.
+        Package* newPackage = arena.create<Package>(
+            (int)packages.size(),
+            mapClients[clientIdx],
+            rewardDist(rng),
+            currentTick + deadlineDist(rng),
+            currentTick,
+            clientIdx
+        );
+        
+        packages.push_back(newPackage);
+        pendingPackages.push_back(newPackage);
+        
+        logEvent(LOG_PACKAGE_SPAWNED, newPackage->id, newPackage->reward, newPackage->deadline);
+        if (trace) {
+            trace->record(TRACE_SPAWN, newPackage->id, newPackage->destCoord.x, newPackage->destCoord.y,
+                          newPackage->reward, newPackage->deadline);
+        }
+    }
+}
 
-        //     // Construim mesajul de telemetrie
-        //     // Format: [DRONE ID] Bat: 85.5% | Pos: (10, 20) | Target: 45.2m
-            
-        //     // Nota: Logarea la fiecare tick va genera un fisier foarte mare!
-        //     // Folosim string stream pentru formatare frumoasa a float-urilor
-        //     std::stringstream ss;
-        //     ss << "[TELEMETRIE DRONA " << agent->getId() << "] "
-        //        << "Bat: " << std::fixed << std::setprecision(1) << agent->getBatteryPercentage() << "% | "
-        //        << "Pos: (" << pos.x << "," << pos.y << ") | "
-        //        << "Status: " << statusTarget;
-            
-        //     if (agent->getPackage()) {
-        //         ss << " | Dist. Dest: " << std::fixed << std::setprecision(2) << distToTarget;
-        //     }
+void Simulation::setTickThreads(unsigned int threads) {
+    tickPool.reset();
+    tickPathfinders.clear();
+    if (threads <= 1) return;
 
-        //     logEvent(ss.str());
-        // }
-	
-	//taxam daca e in miscare sau daca e idle
-        if (!onChargingCell || agent->getState() == MOVING) {
-            totalCosts += agent->getOperationalCost();
-        }
-        
-        if (onChargingCell && agent->getState() != MOVING) {
-            
-            if (agent->getBatteryPercentage() < 100.0f) {
+    tickPool.reset(new ForkJoinPool(threads));
+    tickPathfinders.resize(threads);
+    for (unsigned int p = 1; p < threads; p++) {
+        tickPathfinders[p] = PathfinderFactory::create(pathfinderType);
+    }
+    tickPartials.resize(threads);
+}
 
-		//debug pt drone
-		// if (agent->getType() == DRONE && agent->getState() != CHARGING) {
-                //     std::stringstream ssCharge;
-                //     ssCharge << "[INFO] Drona " << agent->getId() 
-                //              << " a ajuns la statie si INCEPE INCARCAREA. (Baterie curenta: " 
-                //              << std::fixed << std::setprecision(1) << agent->getBatteryPercentage() << "%)";
-                //     logEvent(ssCharge.str());
-                // }
-		
-                agent->setState(CHARGING); 
-                agent->charge();
-                
-            } else {
-                // Bateria e la 100%
-		//debug drone
-		// if (agent->getType() == DRONE && agent->getState() == CHARGING) {
-                //      logEvent("[INFO] Drona " + to_string(agent->getId()) + " a TERMINAT incarcarea (100%).");
-                // }
-                agent->setState(IDLE);
-            }
-            
-        } else {
-            // state = MOVING sau IDLE dar nu pe charging cell
-            float batteryBefore = agent->getBattery();
-            agent->move(*map);
-           
-            if (!agent->isAlive() && batteryBefore > 0) {
+void Simulation::updateAgents() {
+    // Fiecare parte aduna costurile si decesele ei; totalurile se combina
+    // dupa faza, in ordinea partilor. Sunt intregi, deci suma nu depinde
+    // de impartire.
+    FleetTickTotals totals;
+    int n = fleet.size();
+    if (tickPool && n >= PARALLEL_TICK_MIN_AGENTS) {
+        int parts = (int)tickPool->size();
+        tickPool->run([&](int p) {
+            IPathfinder* pf = p == 0 ? fleet.getPathfinder() : tickPathfinders[p].get();
+            tickPartials[p] = fleet.updateRange(*map, (int)((long long)n * p / parts),
+                                                (int)((long long)n * (p + 1) / parts), pf);
+        });
+        for (int p = 0; p < parts; p++) totals.merge(tickPartials[p]);
+    } else {
+        totals = fleet.updateRange(*map, 0, n, fleet.getPathfinder());
+    }
 
-		string typeStr;
-                switch(agent->getType()) {
-                    case DRONE: typeStr = "DRONE"; break;
-                    case ROBOT: typeStr = "ROBOT"; break;
-                    case SCOOTER: typeStr = "SCOOTER"; break;
-                    default: typeStr = "NECUNOSCUT"; break;
-                }
+    totalCosts += totals.cost;
+    agentsLost += totals.deaths;
+    agentsAlive -= totals.deaths;
+    totalPenalties += 500LL * totals.deaths;
 
+    // Evenimentele deceselor raman pe thread-ul simularii, in ordinea sloturilor
+    if (totals.deaths > 0) {
+        fleet.collectDied(diedThisTick);
+    } else {
+        diedThisTick.clear();
+    }
+    
+    for (int slot : diedThisTick) {
+        Agent* agent = fleet.get(slot);
 
-                Point deathPos = agent->getPosition();
-                logEvent("!!! DECES AGENT !!! ID: " + to_string(agent->getId()) + 
-                         " [" + typeStr + "] a murit la coordonatele (" + 
-                         to_string(deathPos.x) + ", " + to_string(deathPos.y) + 
-                         "). Baterie epuizata.");
-			 
-                agentsLost++;
-                agentsAlive--;
-                totalPenalties += 500;
-                if (agent->isBusy()) {
-                    Package* pkg = agent->getPackage();
-                    if (pkg) { 
-                        pkg->assigned = false; 
-                        agent->dropPackage(); 
-                    }
-                }
-            }
-        }
+        Point deathPos = agent->getPosition();
+        logEvent(LOG_AGENT_DIED, agent->getId(), agent->getType(), deathPos.x, deathPos.y);
+        if (trace) trace->record(TRACE_DEATH, agent->getId(), agent->getType(), deathPos.x, deathPos.y);
+         
+        // Pachetul revine in coada; agentul ramane mort
+        fleet.releasePackage(slot);
+    }
+    
+    if (!diedThisTick.empty()) {
+        aliveAgents.erase(remove_if(aliveAgents.begin(), aliveAgents.end(),
+                                    [](const Agent* agent) { return !agent->isAlive(); }),
+                          aliveAgents.end());
     }
 }
 
 void Simulation::processDeliveries() {
-    for (auto& agent : agents) {
-	
+    for (Agent* agent : aliveAgents) {
+
         if (!agent->isAlive() || !agent->isBusy()) continue;
         
         Package* package = agent->getPackage();
@@ -228,19 +244,17 @@ void Simulation::processDeliveries() {
             packagesDelivered++;
             totalRevenue += package->reward;
 
-	    string deliveryMsg = "Pachet " + to_string(package->id) + 
-                                 " RECEPTIONAT de client. Livrat de Agent " + 
-                                 to_string(agent->getId()) + " [" + 
-                                 (agent->getType() == DRONE ? "DRONA" : 
-                                  (agent->getType() == ROBOT ? "ROBOT" : "SCUTER")) + "]";
+            if (trace) {
+                trace->record(TRACE_DELIVER, package->id, agent->getId(),
+                              max(0, currentTick - package->deadline));
+            }
             
             if (currentTick > package->deadline) {
 		totalPenalties += 50;
 		int delay = currentTick - package->deadline;
-                logEvent(deliveryMsg + " cu intarziere (" + to_string(delay) + 
-                        " ticks). Penalizare: 50 credite");
+                logEvent(LOG_DELIVERED_LATE, package->id, agent->getId(), agent->getType(), delay);
             } else {
-                logEvent(deliveryMsg + " la timp.");
+                logEvent(LOG_DELIVERED, package->id, agent->getId(), agent->getType());
             }
             
             agent->dropPackage();
@@ -249,132 +263,171 @@ void Simulation::processDeliveries() {
 }
 
 void Simulation::checkAgentStatus() {
-    agentsAlive = 0;
-    for (auto& agent : agents) {
-        if (agent->isAlive()) {
-            agentsAlive++;
-        }
+    agentsAlive = aliveAgents.size();
+}
+
+// Muta pachetele intre liste dupa starea lor curenta. Parcurge doar pachetele
+// active (in asteptare si in curs de livrare).
+void Simulation::syncPackageLists() {
+    size_t kept = 0;
+    for (size_t i = 0; i < pendingPackages.size(); i++) {
+        Package* package = pendingPackages[i];
+        if (package->assigned) inFlightPackages.push_back(package);
+        else pendingPackages[kept++] = package;
+    }
+    pendingPackages.resize(kept);
+    
+    // Un pachet in curs revine in coada daca agentul l-a abandonat
+    // (trimis la incarcat sau mort)
+    kept = 0;
+    for (size_t i = 0; i < inFlightPackages.size(); i++) {
+        Package* package = inFlightPackages[i];
+        if (package->delivered) finishedPackages.push_back(package);
+        else if (!package->assigned) pendingPackages.push_back(package);
+        else inFlightPackages[kept++] = package;
     }
+    inFlightPackages.resize(kept);
 }
 
-void Simulation::run() {
-    Config* config = Config::getInstance();
+bool Simulation::step() {
+    if (currentTick >= totalTicks) return false;
+    
+    currentTick++;
+    if (trace) trace->setTick(currentTick);
     
-    logEvent("=== SIMULARE INCEPUTA ===");
+    if (currentTick % 100 == 0) {
+      // cout << "Tick " << currentTick << "/" << totalTicks 
+      //       << " | Pachete livrate: " << packagesDelivered 
+      //       << " | Agenti activi: " << agentsAlive << endl;
 
-    logEvent("Simulare pornita. Max ticks: " + to_string(config->maxTicks));
+        logEvent(LOG_HEARTBEAT, currentTick); // In fisier
+    }
     
-    chrono::high_resolution_clock::time_point startTime = chrono::high_resolution_clock::now();
+    uint64_t tickStart = 0;
+    if (profiler) {
+        profiler->start();
+        tickStart = profiler->lastLap();
+    }
     
-    while (currentTick < totalTicks) {
-        currentTick++;
-        
-        if (currentTick % 100 == 0) {
-          // cout << "Tick " << currentTick << "/" << totalTicks 
-          //       << " | Pachete livrate: " << packagesDelivered 
-          //       << " | Agenti activi: " << agentsAlive << endl;
-
-            logEvent("--- HEARTBEAT spawnPackages();: Tick " + to_string(currentTick) + " ---"); // In fisier
-        }
-        
-        spawnPackages();
-        
-        vector<Agent*> rawAgents;
-        for (auto& agent : agents) {
-            rawAgents.push_back(agent.get());
-        }
-        
-        vector<Package*> rawPackages;
-        for (auto& package : packages) {
-            rawPackages.push_back(package.get()); 
-        }
-        
-        hiveMind->update(rawAgents, rawPackages, *map, currentTick);
-        
-        updateAgents();
-        
-        processDeliveries();
-        
-        checkAgentStatus();
-        
-        if (agentsAlive == 0) {
-            logEvent("Toti agentii au murit! Simularea se opreste prematur.");
-            break;
-        }
+    spawnPackages();
+    lap(PHASE_SPAWN);
+    
+    hiveMind->update(aliveAgents, pendingPackages, *map, currentTick);
+    syncPackageLists();
+    lap(PHASE_SYNC_ASSIGNED);
+    
+    updateAgents();
+    lap(PHASE_UPDATE_AGENTS);
+    
+    processDeliveries();
+    lap(PHASE_DELIVERIES);
+    syncPackageLists();
+    lap(PHASE_SYNC_DELIVERED);
+    
+    checkAgentStatus();
+    if (profiler) {
+        profiler->lap(PHASE_CHECK_STATUS);
+        profiler->record(PHASE_TICK, profiler->lastLap() - tickStart);
+    }
+    
+    if (agentsAlive == 0) {
+        logEvent(LOG_ALL_AGENTS_DEAD);
+        return false;
     }
+    return true;
+}
+
+void Simulation::run() {
+    logEvent(LOG_SIM_STARTED);
+
+    logEvent(LOG_SIM_MAX_TICKS, config.maxTicks);
+    
+    chrono::high_resolution_clock::time_point startTime = chrono::high_resolution_clock::now();
+    
+    while (step()) {}
     
     chrono::high_resolution_clock::time_point endTime = chrono::high_resolution_clock::now();
     chrono::milliseconds duration = chrono::duration_cast<chrono::milliseconds>(endTime - startTime);
     
-    for (auto& package : packages) {
-        if (!package->delivered) {
-            totalPenalties += 200;
-            packagesFailed++;
-        }
+    // Tot ce n-a ajuns in lista celor livrate este esuat
+    packagesFailed = pendingPackages.size() + inFlightPackages.size();
+    totalPenalties += 200LL * packagesFailed;
+    if (trace) trace->record(TRACE_SIM_END, packagesDelivered, packagesFailed, zigzagEncode(getTotalProfit()));
+    
+
+    if (!reportPath.empty()) {
+        saveReport(getResult(), reportPath);
+        logEvent(LOG_REPORT_SAVED);
     }
     
+    logEvent(LOG_SIM_FINISHED);
+    logEvent(LOG_SIM_DURATION, (int)duration.count());
+}
 
-    saveStatistics();
+SimulationResult Simulation::getResult() const {
+    SimulationResult result;
+    result.scenario = scenario;
+    result.seed = seed;
+    result.ticksRun = currentTick;
+    result.totalTicks = totalTicks;
+    result.mapWidth = map->getWidth();
+    result.mapHeight = map->getHeight();
+    
+    result.agentsInitial = fleet.size();
+    result.agentsAlive = agentsAlive;
+    result.agentsLost = agentsLost;
+    for (int type = DRONE; type <= SCOOTER; type++) {
+        result.agentsOfType[type] = fleet.countOfType((AgentType)type);
+        result.aliveOfType[type] = fleet.countAlive((AgentType)type);
+    }
+    
+    result.packagesGenerated = packages.size();
+    result.packagesDelivered = packagesDelivered;
+    result.packagesFailed = packagesFailed;
     
-    logEvent("=== SIMULARE TERMINATA ===");
-    logEvent("Durata: " + to_string(duration.count()) + " ms");
+    result.revenue = totalRevenue;
+    result.costs = totalCosts;
+    result.penalties = totalPenalties;
+    result.profit = getTotalProfit();
+    return result;
 }
 
-void Simulation::saveStatistics() {
-    ofstream report("simulation_report.txt");
+void Simulation::saveReport(const SimulationResult& r, const string& path) {
+    ofstream report(path);
     
     if (!report.is_open()) {
         throw std::runtime_error("Eroare: Nu pot crea fisierul de raport!");
     }
     
-    long long totalProfit = totalRevenue - totalCosts - totalPenalties;
-    
     report << "=== RAPORT FINAL SIMULARE HIVEMIND ===\n\n";
     report << "SETARI:\n";
-    report << "Ticks totali: " << totalTicks << "\n";
-    report << "Ticks rulati: " << currentTick << "\n";
-    report << "Dimensiune harta: " << map->getWidth() << "x" << map->getHeight() << "\n";
-    report << "Agenti initiali: " << agents.size() << "\n";
-    report << "Pachete generate: " << packages.size() << "\n\n";
+    report << "Ticks totali: " << r.totalTicks << "\n";
+    report << "Ticks rulati: " << r.ticksRun << "\n";
+    report << "Dimensiune harta: " << r.mapWidth << "x" << r.mapHeight << "\n";
+    report << "Agenti initiali: " << r.agentsInitial << "\n";
+    report << "Pachete generate: " << r.packagesGenerated << "\n\n";
     
     report << "STATISTICI OPERATIONALE:\n";
-    report << "Agenti supravietuiti: " << agentsAlive << "\n";
-    report << "Agenti pierduti: " << agentsLost << "\n";
-    report << "Pachete livrate: " << packagesDelivered << "\n";
-    report << "Pachete nelivrate: " << packagesFailed << "\n";
-    report << "Rata de succes: " << fixed << setprecision(2) 
-           << (packages.empty() ? 0.0 : (packagesDelivered * 100.0 / packages.size())) 
-           << "%\n\n";
+    report << "Agenti supravietuiti: " << r.agentsAlive << "\n";
+    report << "Agenti pierduti: " << r.agentsLost << "\n";
+    report << "Pachete livrate: " << r.packagesDelivered << "\n";
+    report << "Pachete nelivrate: " << r.packagesFailed << "\n";
+    report << "Rata de succes: " << fixed << setprecision(2) << r.successRate() << "%\n\n";
     report << "STATISTICI FINANCIARE:\n";
-    report << "Profit Maxim: " << totalRevenue - totalCosts << " credite\n";
-    report << "Venituri totale: " << totalRevenue << " credite\n";
-    report << "Costuri totale: " << totalCosts << " credite\n";
-    report << "Penalizari totale: " << totalPenalties << " credite\n";
-    report << "  - Agent mort: " << (agentsLost * 500) << " credite\n";
-    report << "  - Pachete intarziate: " << (totalPenalties - (agentsLost * 500) - (packagesFailed * 200)) 
+    report << "Profit Maxim: " << r.revenue - r.costs << " credite\n";
+    report << "Venituri totale: " << r.revenue << " credite\n";
+    report << "Costuri totale: " << r.costs << " credite\n";
+    report << "Penalizari totale: " << r.penalties << " credite\n";
+    report << "  - Agent mort: " << (r.agentsLost * 500) << " credite\n";
+    report << "  - Pachete intarziate: " << (r.penalties - (r.agentsLost * 500) - (r.packagesFailed * 200)) 
            << " credite (50 per pachet)\n";
-    report << "  - Pachete nelivrate: " << (packagesFailed * 200) << " credite (200 per pachet)\n";
-    report << "PROFIT NET: " << totalProfit << " credite\n\n";
+    report << "  - Pachete nelivrate: " << (r.packagesFailed * 200) << " credite (200 per pachet)\n";
+    report << "PROFIT NET: " << r.profit << " credite\n\n";
     
     report << "DETALII AGENTI:\n";
-    int drones = 0, robots = 0, scooters = 0;
-    int dronesAlive = 0, robotsAlive = 0, scootersAlive = 0;
-    
-    for (auto& agent : agents) {
-        switch (agent->getType()) {
-            case DRONE: drones++; if (agent->isAlive()) dronesAlive++; break;
-            case ROBOT: robots++; if (agent->isAlive()) robotsAlive++; break;
-            case SCOOTER: scooters++; if (agent->isAlive()) scootersAlive++; break;
-        }
-    }
-    
-    report << "Drone: " << dronesAlive << "/" << drones << " supravietuitoare\n";
-    report << "Roboti: " << robotsAlive << "/" << robots << " supravietuitoare\n";
-    report << "Scutere: " << scootersAlive << "/" << scooters << " supravietuitoare\n";
-    
-    report.close();
-    
-    logEvent("Raport salvat in simulation_report.txt");
+    report << "Drone: " << r.aliveOfType[DRONE] << "/" << r.agentsOfType[DRONE] << " supravietuitoare\n";
+    report << "Roboti: " << r.aliveOfType[ROBOT] << "/" << r.agentsOfType[ROBOT] << " supravietuitoare\n";
+    report << "Scutere: " << r.aliveOfType[SCOOTER] << "/" << r.agentsOfType[SCOOTER] << " supravietuitoare\n";
 }
 
 void Simulation::printFinalReport() const {
@@ -0,0 +1,367 @@
+#include "sweep.h"
+#include "scheduler.h"
+#include "simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+typedef HiveMind::OptimizationParams Params;
+
+namespace {
+
+// Candidatii sunt esantionati din alt sir decat scenariile
+const unsigned long long SWEEP_SEED_SALT = 0x7377656570ULL;
+
+// Loturi mici: o evaluare e o simulare completa, de durata foarte variabila
+const int SWEEP_CHUNK = 16;
+
+// Halving-ul se opreste cand raman atatia candidati
+const int FINAL_CANDIDATES = 8;
+
+struct ParamRange {
+    string name;
+    double Params::* real;
+    int Params::* integer;
+    double low;
+    double high;
+    bool logScale;
+};
+
+ParamRange knownParam(const string& name) {
+    static const ParamRange known[] = {
+        {"profitWeight", &Params::profitWeight, nullptr, 0.0, 1.0, false},
+        {"safetyWeight", &Params::safetyWeight, nullptr, 0.0, 1.0, false},
+        {"urgencyWeight", &Params::urgencyWeight, nullptr, 0.0, 1.0, false},
+        {"distanceWeight", &Params::distanceWeight, nullptr, 0.0, 1.0, false},
+        {"criticalBatteryThreshold", nullptr, &Params::criticalBatteryThreshold, 5, 40, false},
+        {"lowBatteryThreshold", nullptr, &Params::lowBatteryThreshold, 20, 60, false},
+        {"safeBatteryMargin", nullptr, &Params::safeBatteryMargin, 0, 60, false},
+    };
+    for (const auto& range : known) {
+        if (range.name == name) return range;
+    }
+    throw invalid_argument("Parametru necunoscut pentru --sweep: " + name);
+}
+
+// lowBatteryThreshold nu e folosit de HiveMind, deci nu e cautat implicit
+vector<ParamRange> defaultRanges() {
+    vector<ParamRange> ranges;
+    for (const char* name : {"profitWeight", "safetyWeight", "urgencyWeight", "distanceWeight",
+                             "criticalBatteryThreshold", "safeBatteryMargin"}) {
+        ranges.push_back(knownParam(name));
+    }
+    return ranges;
+}
+
+vector<ParamRange> loadRanges(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        throw runtime_error("Eroare deschidere fisier: " + path);
+    }
+
+    vector<ParamRange> ranges;
+    string line, name, scale;
+    while (getline(file, line)) {
+        if (line.empty() || line.find("//") == 0) continue;
+        stringstream ss(line);
+        ss >> name;
+        ParamRange range = knownParam(name);
+        if (!(ss >> range.low >> range.high) || range.low > range.high) {
+            throw runtime_error("Interval invalid pentru " + name + " in " + path);
+        }
+        range.logScale = (ss >> scale) && scale == "log";
+        if (range.logScale && range.low <= 0) {
+            throw runtime_error("Intervalul logaritmic pentru " + name + " trebuie sa fie pozitiv");
+        }
+        ranges.push_back(range);
+    }
+    if (ranges.empty()) throw runtime_error("Niciun parametru de cautat in " + path);
+    return ranges;
+}
+
+Params sampleParams(const vector<ParamRange>& ranges, mt19937& rng) {
+    Params params;
+    for (const auto& range : ranges) {
+        double value;
+        if (range.logScale) {
+            uniform_real_distribution<double> dist(log(range.low), log(range.high));
+            value = exp(dist(rng));
+        } else {
+            uniform_real_distribution<double> dist(range.low, range.high);
+            value = dist(rng);
+        }
+        if (range.real) params.*range.real = value;
+        else params.*range.integer = (int)lround(value);
+    }
+    return params;
+}
+
+struct Candidate {
+    Params params;
+    bool active = true;
+    bool excluded = false;   // scos din cauza simularilor esuate
+    long long runs = 0;      // doar simularile reusite
+    long long failed = 0;
+    double profit = 0.0;     // suma pe scenariile evaluate cu succes
+    double survival = 0.0;   // suma fractiilor de agenti supravietuiti
+
+    double meanProfit() const { return runs ? profit / runs : 0.0; }
+    double survivalPercent() const { return runs ? 100.0 * survival / runs : 0.0; }
+};
+
+bool dominates(const Candidate& a, const Candidate& b) {
+    return a.meanProfit() >= b.meanProfit() && a.survivalPercent() >= b.survivalPercent() &&
+           (a.meanProfit() > b.meanProfit() || a.survivalPercent() > b.survivalPercent());
+}
+
+// Rangul Pareto (0 = nedominat) al fiecarui candidat din `pool`
+vector<int> paretoRanks(const vector<Candidate>& candidates, const vector<int>& pool) {
+    vector<int> rank(pool.size(), -1);
+    size_t assigned = 0;
+    for (int layer = 0; assigned < pool.size(); layer++) {
+        vector<size_t> front;
+        for (size_t i = 0; i < pool.size(); i++) {
+            if (rank[i] != -1) continue;
+            bool dominated = false;
+            for (size_t j = 0; j < pool.size() && !dominated; j++) {
+                if (j == i || (rank[j] != -1 && rank[j] < layer)) continue;
+                dominated = dominates(candidates[pool[j]], candidates[pool[i]]);
+            }
+            if (!dominated) front.push_back(i);
+        }
+        for (size_t i : front) rank[i] = layer;
+        assigned += front.size();
+    }
+    return rank;
+}
+
+struct EvalSums {
+    long long runs = 0;
+    long long failed = 0;
+    double profit = 0.0;
+    double survival = 0.0;
+};
+
+// Starea unui thread: cate o simulare per configuratie, ca in --benchmark
+struct SweepWorker {
+    vector<unique_ptr<Simulation>> sims;
+    vector<EvalSums> sums;   // dupa indexul candidatului
+};
+
+class SweepRunner {
+public:
+    SweepRunner(const SweepSettings& _settings, const vector<ScenarioConfig>& _configs,
+                const MapCorpus& _maps)
+        : settings(_settings), configs(_configs), maps(_maps), workers(_settings.numThreads),
+          scheduler(_settings.numThreads), simulations(0) {}
+
+    // Evalueaza candidatii activi pe scenariile [from, to) si aduna rezultatele
+    void evaluate(vector<Candidate>& candidates, int from, int to) {
+        vector<int> active;
+        for (int c = 0; c < (int)candidates.size(); c++) {
+            if (candidates[c].active) active.push_back(c);
+        }
+        int span = to - from;
+        if (span <= 0 || active.empty()) return;
+
+        for (auto& worker : workers) worker.sums.assign(candidates.size(), EvalSums());
+
+        scheduler.start((int)active.size() * span, SWEEP_CHUNK, [&](int w, int begin, int end) {
+            SweepWorker& worker = workers[w];
+            for (int k = begin; k < end; k++) {
+                int candidate = active[k / span];
+                int scenario = from + k % span;
+                int configIndex = scenario % (int)configs.size();
+                EvalSums& sums = worker.sums[candidate];
+                try {
+                    Simulation& sim = simulationFor(worker, configIndex);
+                    sim.reset(Simulation::scenarioSeed(settings.seedBase, scenario));
+                    sim.setOptimizationParams(candidates[candidate].params);
+                    if (!maps.empty()) sim.setSharedMap(maps.get(scenario));
+                    sim.initialize(scenario);
+                    sim.run();
+
+                    SimulationResult result = sim.getResult();
+                    sums.profit += result.profit;
+                    sums.survival += result.agentsInitial
+                        ? (double)result.agentsAlive / result.agentsInitial : 0.0;
+                    sums.runs++;
+                } catch (const exception&) {
+                    sums.failed++;
+                }
+            }
+        });
+        scheduler.wait();
+
+        for (const auto& worker : workers) {
+            for (size_t c = 0; c < candidates.size(); c++) {
+                candidates[c].runs += worker.sums[c].runs;
+                candidates[c].failed += worker.sums[c].failed;
+                candidates[c].profit += worker.sums[c].profit;
+                candidates[c].survival += worker.sums[c].survival;
+            }
+        }
+        simulations += (long long)active.size() * span;
+    }
+
+    long long getSimulations() const { return simulations; }
+
+private:
+    const SweepSettings& settings;
+    const vector<ScenarioConfig>& configs;
+    const MapCorpus& maps;
+    vector<SweepWorker> workers;
+    WorkStealingScheduler scheduler;
+    long long simulations;
+
+    Simulation& simulationFor(SweepWorker& worker, int configIndex) {
+        if (worker.sims.empty()) worker.sims.resize(configs.size());
+        unique_ptr<Simulation>& sim = worker.sims[configIndex];
+        if (!sim) {
+            sim.reset(new Simulation(configs[configIndex], false, settings.pathfinderType));
+            sim->setAssignmentMode(settings.assignmentMode);
+        }
+        return *sim;
+    }
+};
+
+void printParamsHeader() {
+    cout << setw(10) << "PROFIT" << setw(10) << "SUPRAV%" << setw(9) << "PROFIT_W"
+         << setw(9) << "SIGUR_W" << setw(9) << "URGENT_W" << setw(9) << "DIST_W"
+         << setw(8) << "CRITIC" << setw(7) << "SCAZUT" << setw(7) << "MARJA" << endl;
+}
+
+void printCandidate(const Candidate& c, const string& note) {
+    const Params& p = c.params;
+    cout << fixed << setprecision(1) << setw(10) << c.meanProfit() << setw(10) << c.survivalPercent()
+         << setprecision(3) << setw(9) << p.profitWeight << setw(9) << p.safetyWeight
+         << setw(9) << p.urgencyWeight << setw(9) << p.distanceWeight
+         << setw(8) << p.criticalBatteryThreshold << setw(7) << p.lowBatteryThreshold
+         << setw(7) << p.safeBatteryMargin << "  " << note << endl;
+}
+
+}  // namespace
+
+void runParameterSweep(const SweepSettings& settings, const vector<ScenarioConfig>& configs,
+                       const MapCorpus& maps) {
+    vector<ParamRange> ranges = settings.specPath.empty() ? defaultRanges() : loadRanges(settings.specPath);
+
+    // Candidatul 0 are parametrii impliciti: referinta, evaluat mereu pe tot corpusul
+    vector<Candidate> candidates(max(settings.candidates, 1) + 1);
+    mt19937 rng((unsigned int)(settings.seedBase ^ SWEEP_SEED_SALT));
+    for (size_t c = 1; c < candidates.size(); c++) candidates[c].params = sampleParams(ranges, rng);
+
+    cout << "--- CAUTARE PARAMETRI HIVEMIND ---" << endl;
+    cout << "Parametri cautati:";
+    for (const auto& range : ranges) {
+        cout << " " << range.name << "[" << range.low << ", " << range.high
+             << (range.logScale ? ", log" : "") << "]";
+    }
+    cout << endl;
+    cout << settings.candidates << " candidati, " << settings.corpusSize << " scenarii (seed-base "
+         << settings.seedBase << "), " << settings.numThreads << " thread-uri, "
+         << (settings.successiveHalving ? "successive halving" : "cautare aleatoare") << "." << endl;
+
+    // Halving: fiecare runda dubleaza scenariile si pastreaza jumatatea mai
+    // buna (rang Pareto, apoi profit); ultima runda ajunge la tot corpusul.
+    // Scenariile deja evaluate nu se repeta, doar se adauga cele noi.
+    int rounds = 1;
+    if (settings.successiveHalving) {
+        while ((settings.candidates >> rounds) >= FINAL_CANDIDATES &&
+               (settings.corpusSize >> rounds) >= 1) {
+            rounds++;
+        }
+    }
+
+    SweepRunner runner(settings, configs, maps);
+    auto startTime = chrono::steady_clock::now();
+    int evaluated = 0;
+    for (int round = 0; round < rounds; round++) {
+        int budget = settings.corpusSize >> (rounds - 1 - round);
+        runner.evaluate(candidates, evaluated, budget);
+        evaluated = budget;
+
+        // Candidatii activi si referinta au acum aceleasi scenarii. Esecurile
+        // pe care le are si referinta tin de scenariu; peste ele, media
+        // candidatului ar veni din mai putine scenarii, deci e scos.
+        for (size_t c = 1; c < candidates.size(); c++) {
+            if (candidates[c].active && candidates[c].failed > candidates[0].failed) {
+                candidates[c].active = false;
+                candidates[c].excluded = true;
+            }
+        }
+
+        vector<int> pool;
+        for (int c = 1; c < (int)candidates.size(); c++) {
+            if (candidates[c].active) pool.push_back(c);
+        }
+        cout << "Runda " << round + 1 << "/" << rounds << ": " << pool.size()
+             << " candidati pe " << budget << " scenarii" << endl;
+        if (round == rounds - 1) break;
+
+        vector<int> rank = paretoRanks(candidates, pool);
+        vector<size_t> order(pool.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = i;
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (rank[a] != rank[b]) return rank[a] < rank[b];
+            return candidates[pool[a]].meanProfit() > candidates[pool[b]].meanProfit();
+        });
+        for (size_t i = (pool.size() + 1) / 2; i < order.size(); i++) {
+            candidates[pool[order[i]]].active = false;
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - startTime;
+
+    vector<int> finalists;
+    for (int c = 0; c < (int)candidates.size(); c++) {
+        if (candidates[c].active) finalists.push_back(c);
+    }
+    vector<int> rank = paretoRanks(candidates, finalists);
+    vector<int> front;
+    for (size_t i = 0; i < finalists.size(); i++) {
+        if (rank[i] == 0) front.push_back(finalists[i]);
+    }
+    sort(front.begin(), front.end(), [&](int a, int b) {
+        return candidates[a].meanProfit() > candidates[b].meanProfit();
+    });
+
+    long long failed = 0;
+    vector<int> excluded;
+    for (int c = 0; c < (int)candidates.size(); c++) {
+        failed += candidates[c].failed;
+        if (candidates[c].excluded) excluded.push_back(c);
+    }
+
+    cout << "\n========================================" << endl;
+    cout << "Simulari:            " << runner.getSimulations() << " in " << fixed << setprecision(2)
+         << elapsed.count() << " secunde (" << (int)(runner.getSimulations() / elapsed.count())
+         << " simulari/sec)" << endl;
+    cout << "Simulari esuate:     " << failed << endl;
+    cout << "FRONT PARETO (" << front.size() << " din " << finalists.size()
+         << " finalisti, pe " << settings.corpusSize << " scenarii)" << endl;
+    printParamsHeader();
+    for (int c : front) printCandidate(candidates[c], c == 0 ? "implicit" : "");
+    if (rank[0] != 0) {
+        cout << "Referinta (dominata):" << endl;
+        printCandidate(candidates[0], "implicit");
+    }
+    if (candidates[0].failed > 0) {
+        cout << "Referinta: " << candidates[0].failed << " simulari esuate, excluse din medii" << endl;
+    }
+    if (!excluded.empty()) {
+        cout << "Candidati exclusi (simulari esuate peste referinta): " << excluded.size() << endl;
+        for (int c : excluded) {
+            printCandidate(candidates[c], to_string(candidates[c].failed) + " esuate");
+        }
+    }
+    cout << "========================================" << endl;
+}
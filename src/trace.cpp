@@ -0,0 +1,92 @@
+#include "trace.h"
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+const char TRACE_MAGIC[8] = {'H', 'M', 'T', 'R', 'A', 'C', 'E', '1'};
+
+static const char* EVENT_NAMES[TRACE_EVENT_COUNT] = {
+    "?", "SIM_BEGIN", "SPAWN", "ASSIGN", "CHARGE", "DEATH", "DELIVER", "SIM_END"
+};
+
+const char* traceEventName(TraceEvent type) {
+    return type < TRACE_EVENT_COUNT ? EVENT_NAMES[type] : "?";
+}
+
+TraceWriter::TraceWriter(const string& _path)
+    : path(_path), file(fopen(_path.c_str(), "wb")), writeFailed(false),
+      currentTick(0), lastTick(0) {
+    buffer.reserve(FLUSH_BYTES + 64);
+    if (file) buffer.insert(buffer.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+}
+
+TraceWriter::~TraceWriter() {
+    if (file) {
+        flush();
+        fclose(file);
+    }
+}
+
+void TraceWriter::flush() {
+    if (file && !writeFailed && !buffer.empty() &&
+        fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        writeFailed = true;
+    }
+    buffer.clear();
+}
+
+void TraceWriter::close() {
+    if (!file) return;
+    flush();
+    bool failed = writeFailed || fclose(file) != 0;
+    file = nullptr;
+    if (failed) throw runtime_error("Scriere esuata in urma " + path + "; fisierul e incomplet");
+}
+
+void TraceWriter::beginSimulation(uint32_t scenario, uint32_t seed) {
+    currentTick = 0;
+    lastTick = 0;
+    record(TRACE_SIM_BEGIN, scenario, seed);
+}
+
+TraceReader::TraceReader(const uint8_t* _data, size_t _size)
+    : data(_data), size(_size), pos(sizeof(TRACE_MAGIC)), scenario(0), tick(0) {}
+
+bool TraceReader::hasValidHeader() const {
+    return size >= sizeof(TRACE_MAGIC) && memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+}
+
+bool TraceReader::getVarint(uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+        uint8_t byte = data[pos++];
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool TraceReader::next(TraceRecord& record) {
+    if (pos >= size) return false;
+
+    record.type = (TraceEvent)data[pos++];
+    if (record.type == 0 || record.type >= TRACE_EVENT_COUNT) {
+        throw runtime_error("Urma corupta: tip de inregistrare necunoscut");
+    }
+
+    uint64_t delta;
+    if (!getVarint(delta)) throw runtime_error("Urma trunchiata");
+    if (record.type == TRACE_SIM_BEGIN) tick = 0;
+    tick += (int)delta;
+
+    memset(record.fields, 0, sizeof(record.fields));
+    for (int i = 0; i < traceFieldCount(record.type); i++) {
+        if (!getVarint(record.fields[i])) throw runtime_error("Urma trunchiata");
+    }
+    if (record.type == TRACE_SIM_BEGIN) scenario = (uint32_t)record.fields[0];
+
+    record.scenario = scenario;
+    record.tick = tick;
+    return true;
+}
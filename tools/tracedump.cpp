@@ -0,0 +1,109 @@
+// Decodorul urmelor binare scrise cu --trace.
+// Utilizare: tracedump [--csv] FISIER...
+#include "trace.h"
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+static const char* FIELD_NAMES[TRACE_EVENT_COUNT][5] = {
+    {},
+    {"scenariu", "seed"},
+    {"pachet", "x", "y", "reward", "deadline"},
+    {"agent", "pachet"},
+    {"agent", "x", "y"},
+    {"agent", "tip", "x", "y"},
+    {"pachet", "agent", "intarziere"},
+    {"livrate", "esuate", "profit"}
+};
+
+static long long fieldValue(const TraceRecord& r, int i) {
+    // Profitul final e singurul camp cu semn
+    if (r.type == TRACE_SIM_END && i == 2) return zigzagDecode(r.fields[i]);
+    return (long long)r.fields[i];
+}
+
+static void printText(const TraceRecord& r) {
+    cout << "[SIM " << r.scenario << "] [TICK " << r.tick << "] " << traceEventName(r.type);
+    for (int i = 0; i < traceFieldCount(r.type); i++) {
+        cout << ' ' << FIELD_NAMES[r.type][i] << '=' << fieldValue(r, i);
+    }
+    cout << '\n';
+}
+
+static void printCsv(const TraceRecord& r) {
+    cout << r.scenario << ',' << r.tick << ',' << traceEventName(r.type);
+    for (int i = 0; i < 5; i++) {
+        cout << ',';
+        if (i < traceFieldCount(r.type)) cout << fieldValue(r, i);
+    }
+    cout << '\n';
+}
+
+static size_t dumpFile(const string& path, bool csv) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("Nu pot deschide " + path);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        throw runtime_error("Urma goala sau inaccesibila: " + path);
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) throw runtime_error("mmap esuat pentru " + path);
+
+    TraceReader reader((const uint8_t*)mapped, size);
+    size_t count = 0;
+    try {
+        if (!reader.hasValidHeader()) throw runtime_error("Nu este o urma HiveMind: " + path);
+        TraceRecord record;
+        while (reader.next(record)) {
+            if (csv) printCsv(record);
+            else printText(record);
+            count++;
+        }
+    } catch (...) {
+        munmap(mapped, size);
+        throw;
+    }
+
+    munmap(mapped, size);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    bool csv = false;
+    vector<string> paths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) csv = true;
+        else paths.push_back(argv[i]);
+    }
+
+    if (paths.empty()) {
+        cerr << "Utilizare: " << argv[0] << " [--csv] FISIER..." << endl;
+        return 1;
+    }
+
+    try {
+        if (csv) cout << "scenario,tick,event,f0,f1,f2,f3,f4\n";
+        for (const auto& path : paths) {
+            size_t count = dumpFile(path, csv);
+            cerr << path << ": " << count << " inregistrari" << endl;
+        }
+    } catch (const exception& e) {
+        cout.flush();
+        cerr << "Eroare: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}